@@ -137,6 +137,17 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
     ),
 };
 
+/* Finger per key - times hold-tap keys by position on every layer.
+ * See FINGER PROFILES in naughtyusername.h.
+ */
+const uint8_t PROGMEM hold_tap_fingers[MATRIX_ROWS][MATRIX_COLS] = LAYOUT_mitosis_wrapper(
+    ___FINGER_L___,                     ___FINGER_R___,
+    ___FINGER_L___,                     ___FINGER_R___,
+    ___FINGER_L___,                     ___FINGER_R___,
+    ___MITOSIS_THUMB_FINGER_L1___,      ___MITOSIS_THUMB_FINGER_R1___,
+    ___MITOSIS_THUMB_FINGER_L2___,      ___MITOSIS_THUMB_FINGER_R2___
+);
+
 // clang-format on
 
 /* ==========================================================================
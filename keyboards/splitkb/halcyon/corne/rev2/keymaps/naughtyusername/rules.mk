@@ -35,6 +35,12 @@ OLED_ENABLE = no
 POINTING_DEVICE_ENABLE = yes
 POINTING_DEVICE_DRIVER = cirque_pinnacle_spi
 
+# Home row Ctrl/Shift go out on press, so mod + trackpad click has no delay
+SPECULATIVE_HOLD = yes
+
+# Combos with nothing bigger left to wait for fire on the last press
+COMBO_EARLY_FIRE = yes
+
 # RGB Matrix (per-key RGB)
 # The Halcyon Corne has RGB, enable if you want it
 RGB_MATRIX_ENABLE = yes
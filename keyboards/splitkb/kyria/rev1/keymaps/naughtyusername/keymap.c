@@ -109,6 +109,16 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
     // MOUSE layer removed - only needed on Corne (with trackpad)
 };
 
+/* Finger per key - times hold-tap keys by position on every layer.
+ * See FINGER PROFILES in naughtyusername.h.
+ */
+const uint8_t PROGMEM hold_tap_fingers[MATRIX_ROWS][MATRIX_COLS] = LAYOUT_kyria_wrapper(
+    ___FINGER_L_6___,                   ___FINGER_R_6___,
+    ___FINGER_L_6___,                   ___FINGER_R_6___,
+    ___FINGER_L3_8___,                  ___FINGER_R3_8___,
+                     ___KYRIA_THUMB_FINGER___
+);
+
 /* ==========================================================================
  * KYRIA-SPECIFIC OVERRIDES
  * ==========================================================================
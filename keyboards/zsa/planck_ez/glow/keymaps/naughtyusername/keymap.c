@@ -137,6 +137,16 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
     ),
 
 };
+
+/* Finger per key - times hold-tap keys by position on every layer.
+ * See FINGER PROFILES in naughtyusername.h.
+ */
+const uint8_t PROGMEM hold_tap_fingers[MATRIX_ROWS][MATRIX_COLS] = LAYOUT_planck_wrapper(
+    ___FINGER_L_6___,                   ___FINGER_R_6___,
+    ___FINGER_L_6___,                   ___FINGER_R_6___,
+    ___FINGER_L_6___,                   ___FINGER_R_6___,
+                  ___PLANCK_BOTTOM_FINGER___
+);
 // clang-format on
 
 /* ==========================================================================
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+# Copyright 2025 naughtyusername
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+# combo_stats.py - Dump per-combo hit / miss counters over raw HID
+#
+# Needs a keymap built with COMBO_STATS = yes (see users/naughtyusername/
+# combo_stats.c for what each counter means) and the hidapi module:
+#   pip install hid
+#
+# Usage:
+#   ./tools/combo_stats.py            # table of every combo
+#   ./tools/combo_stats.py --reset    # zero the counters on the board
+
+import argparse
+import sys
+
+import hid
+
+# QMK raw HID interface
+RAW_USAGE_PAGE = 0xFF60
+RAW_USAGE = 0x61
+RAW_EPSIZE = 32
+
+CMD_INFO = 0x40
+CMD_READ = 0x41
+CMD_NAME = 0x42
+CMD_RESET = 0x43
+
+STAT_NAMES = ["fired", "timeout", "rejected", "released"]
+
+
+def find_device():
+    for info in hid.enumerate():
+        if info["usage_page"] == RAW_USAGE_PAGE and info["usage"] == RAW_USAGE:
+            dev = hid.Device(path=info["path"])
+            return dev, info
+    sys.exit("no raw HID device found (is COMBO_STATS = yes flashed?)")
+
+
+def command(dev, cmd, *args):
+    packet = bytes([cmd, *args]).ljust(RAW_EPSIZE, b"\0")
+    # Leading 0 is the report id, hidapi wants it on every platform
+    dev.write(b"\0" + packet)
+    reply = dev.read(RAW_EPSIZE, timeout=1000)
+    if not reply or reply[0] != cmd:
+        sys.exit(f"no reply to command 0x{cmd:02x}")
+    if reply[1] != 0:
+        sys.exit(f"command 0x{cmd:02x} failed with status 0x{reply[1]:02x}")
+    return reply
+
+
+def read_stats(dev):
+    info = command(dev, CMD_INFO)
+    count, per_combo = info[2], info[3]
+
+    rows = []
+    index = 0
+    while index < count:
+        reply = command(dev, CMD_READ, index)
+        n = reply[3]
+        data = reply[4:]
+        for i in range(n):
+            offset = i * per_combo * 2
+            counters = [
+                int.from_bytes(data[offset + s * 2 : offset + s * 2 + 2], "little")
+                for s in range(per_combo)
+            ]
+            rows.append(counters)
+        index += n
+
+    names = []
+    for i in range(count):
+        reply = command(dev, CMD_NAME, i)
+        names.append(bytes(reply[2:]).split(b"\0")[0].decode())
+    return names, rows
+
+
+def print_table(names, rows):
+    width = max(len(n) for n in names)
+    print(f"{'combo':<{width}}  " + "  ".join(f"{s:>8}" for s in STAT_NAMES) + "  hit%")
+    for name, counters in zip(names, rows):
+        fired = counters[0]
+        attempts = sum(counters)
+        hit = f"{100 * fired / attempts:5.1f}" if attempts else "    -"
+        print(f"{name:<{width}}  " + "  ".join(f"{c:>8}" for c in counters) + f"  {hit}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--reset", action="store_true", help="zero all counters")
+    args = parser.parse_args()
+
+    dev, info = find_device()
+    print(f"{info['manufacturer_string']} {info['product_string']}")
+
+    if args.reset:
+        command(dev, CMD_RESET)
+        print("counters reset")
+        return
+
+    names, rows = read_stats(dev)
+    print_table(names, rows)
+
+
+if __name__ == "__main__":
+    main()
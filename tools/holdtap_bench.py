@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+# Copyright 2025 naughtyusername
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+# holdtap_bench.py - How much latency each hold-tap key adds
+#
+# Builds the same host binary as tools/replay.py and runs typing patterns
+# through it, so every press goes through the real get_tapping_term(),
+# get_chordal_hold(), get_flow_tap_term() and get_quick_tap_term() (and the
+# combo engine in front of them). For each press it takes the time from the
+# physical press to the HID report that carries it - the tap keycode, or
+# the mods for a hold (press time if speculative hold sent them early) -
+# and prints p50 / p99 and a histogram per hold-tap key on BASE.
+#
+# Patterns, per hold-tap key, with seeded random timing:
+#   tap     the key on its own                          (should tap)
+#   flow    typed right after a letter                  (should tap)
+#   roll    rolled into a letter on the other hand      (should tap)
+#   chord   held, a letter on the other hand tapped     (should hold)
+#   hold    held on its own past the term               (should hold)
+# "wrong" counts presses that didn't resolve the way the pattern meant.
+# Recorded traces (tools/replay.py format) can be added with --trace.
+#
+# Usage:
+#   ./tools/holdtap_bench.py                        # every hold-tap key
+#   ./tools/holdtap_bench.py --samples 200 --seed 7
+#   ./tools/holdtap_bench.py --key f --key j        # just these keys
+#   ./tools/holdtap_bench.py --trace tools/traces/holdtap.trace
+#   ./tools/holdtap_bench.py --feature TYPING_SPEED_TERM
+
+import argparse
+import random
+import sys
+import tempfile
+from pathlib import Path
+
+import replay
+
+PATTERNS = ["tap", "flow", "roll", "chord", "hold"]
+EXPECTED = {"tap": "tap", "flow": "tap", "roll": "tap", "chord": "hold",
+            "hold": "hold"}
+
+# Every sample starts this long after the previous one, so nothing carries
+# over between them (quick tap, flow tap, Caps Word...)
+SAMPLE_GAP_MS = 2000
+
+HIST_BUCKET_MS = 25
+HIST_WIDTH = 40
+
+
+def is_tap_hold(keycode):
+    return 0x2000 <= keycode <= 0x4FFF  # QK_MOD_TAP .. QK_LAYER_TAP
+
+
+def pattern_events(pattern, key, other, rng):
+    """One sample: [(ms, pressed, pos)] and the other key involved."""
+    if pattern == "tap":
+        return [(0, True, key), (rng.randint(40, 120), False, key)]
+    if pattern == "flow":
+        gap = rng.randint(60, 140)
+        return [(0, True, other), (rng.randint(30, 70), False, other),
+                (gap, True, key), (gap + rng.randint(40, 100), False, key)]
+    if pattern == "roll":
+        gap = rng.randint(50, 110)
+        return [(0, True, key), (gap, True, other),
+                (gap + rng.randint(10, 50), False, key),
+                (gap + rng.randint(60, 110), False, other)]
+    if pattern == "chord":
+        gap = rng.randint(60, 150)
+        up = gap + rng.randint(40, 90)
+        return [(0, True, key), (gap, True, other), (up, False, other),
+                (up + rng.randint(20, 80), False, key)]
+    # hold
+    return [(0, True, key), (rng.randint(300, 500), False, key)]
+
+
+def percentile(values, p):
+    """Nearest-rank percentile."""
+    ordered = sorted(values)
+    rank = max(0, min(len(ordered) - 1, round(p / 100 * len(ordered)) - 1))
+    return ordered[rank]
+
+
+def emissions(lines):
+    """E lines: (press ms, latency ms, (row, col), kind)."""
+    out = []
+    for line in lines:
+        fields = line.split()
+        if fields[0] == "E":
+            press, emit = int(fields[1]), int(fields[2])
+            pos = (int(fields[3]), int(fields[4]))
+            out.append((press - replay.START_MS, emit - press, pos, fields[6]))
+    return out
+
+
+def run_pattern(binary, pattern, key, others, samples, rng):
+    """[(latency, kind, expected)] for the key, and the latencies of the
+    other keys pressed in the same samples."""
+    events = []
+    for i in range(samples):
+        start = i * SAMPLE_GAP_MS
+        other = rng.choice(others)
+        events += [(start + ms, pressed, pos) for ms, pressed, pos in
+                   pattern_events(pattern, key, other, rng)]
+
+    found = []
+    behind = []
+    lines = replay.run(binary, events, samples * SAMPLE_GAP_MS)
+    for _, latency, pos, kind in emissions(lines):
+        if pos == key:
+            found.append((latency, kind, EXPECTED[pattern]))
+        else:
+            behind.append(latency)
+    return found, behind
+
+
+def run_traces(binary, traces, names):
+    """Every press in the recorded traces: [(latency, pos, kind)]."""
+    out = []
+    for trace in traces:
+        for _, events, _, _ in replay.parse_trace(trace, names):
+            end = max(ms for ms, _, _ in events) + replay.SETTLE_MS
+            for _, latency, pos, kind in emissions(
+                    replay.run(binary, events, end)):
+                out.append((latency, pos, kind))
+    return out
+
+
+def summary(latencies):
+    if not latencies:
+        return f"{'-':>5} {'-':>5}"
+    return f"{percentile(latencies, 50):5d} {percentile(latencies, 99):5d}"
+
+
+def histogram(latencies):
+    top = max(latencies)
+    buckets = [0] * (top // HIST_BUCKET_MS + 1)
+    for latency in latencies:
+        buckets[latency // HIST_BUCKET_MS] += 1
+    most = max(buckets)
+    for i, count in enumerate(buckets):
+        lo = i * HIST_BUCKET_MS
+        bar = "#" * max(1 if count else 0, count * HIST_WIDTH // most)
+        print(f"      {lo:4d}-{lo + HIST_BUCKET_MS - 1:<4d} ms "
+              f"{count:5d} {bar}")
+
+
+def key_label(pos, keycode):
+    tap = keycode & 0xFF
+    name = replay.HID_NAMES.get(tap, (f"0x{tap:02x}",))[0]
+    name = "spc" if name == " " else name
+    kind = "MT" if keycode < 0x4000 else "LT"
+    return f"{name} ({kind} r{pos[0]}c{pos[1]})"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--keymap", type=Path, default=replay.DEFAULT_KEYMAP,
+                        help="keymap directory to build")
+    parser.add_argument("--feature", action="append", default=[],
+                        help="turn on a userspace opt-in, e.g. "
+                             "TYPING_SPEED_TERM")
+    parser.add_argument("--key", action="append", default=[],
+                        help="only this hold-tap key (BASE name, e.g. f)")
+    parser.add_argument("--samples", type=int, default=50,
+                        help="samples per key and pattern (default 50)")
+    parser.add_argument("--seed", type=int, default=1,
+                        help="random seed (default 1)")
+    parser.add_argument("--trace", action="append", type=Path, default=[],
+                        help="recorded trace to add (tools/replay.py format)")
+    parser.add_argument("--no-hist", action="store_true",
+                        help="only the p50 / p99 tables")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as workdir:
+        binary = replay.build(args.keymap, args.feature, workdir)
+        names, keycodes, hands = replay.key_positions(binary)
+
+        keys = [pos for pos in sorted(keycodes) if is_tap_hold(keycodes[pos])]
+        if args.key:
+            missing = [name for name in args.key if name not in names]
+            if missing:
+                sys.exit(f"no key {', '.join(missing)} on BASE")
+            keys = [pos for pos in keys
+                    if pos in [names[name] for name in args.key]]
+        if not keys:
+            sys.exit("no hold-tap keys to bench")
+
+        # Plain letters to roll / chord with
+        letters = [pos for pos in sorted(keycodes)
+                   if 0x04 <= keycodes[pos] <= 0x1D]
+
+        recorded = run_traces(binary, args.trace, names)
+
+        print(f"{'key':<18} {'pattern':<7} {'n':>5} {'tap':>5} {'hold':>5} "
+              f"{'combo':>5} {'wrong':>5} {'p50':>5} {'p99':>5}  ms")
+        for pos in keys:
+            label = key_label(pos, keycodes[pos])
+            opposite = [p for p in letters if hands[p] != hands[pos]]
+
+            # Per key, so --key doesn't change a key's numbers
+            rng = random.Random(f"{args.seed}:{pos[0]}:{pos[1]}")
+            results = {}
+            everything = []
+            behind = []
+            for pattern in PATTERNS:
+                others = letters if pattern == "flow" else opposite
+                results[pattern], waited = run_pattern(
+                    binary, pattern, pos, others, args.samples, rng)
+                behind += waited
+            traced = [(latency, kind, None)
+                      for latency, p, kind in recorded if p == pos]
+            if traced:
+                results["trace"] = traced
+
+            for pattern, found in results.items():
+                latencies = [latency for latency, _, _ in found]
+                everything += latencies
+                kinds = [kind for _, kind, _ in found]
+                wrong = sum(1 for _, kind, want in found
+                            if want is not None and kind in ("tap", "hold")
+                            and kind != want)
+                print(f"{label:<18} {pattern:<7} {len(found):5d} "
+                      f"{kinds.count('tap'):5d} {kinds.count('hold'):5d} "
+                      f"{kinds.count('combo'):5d} {wrong:5d} "
+                      f"{summary(latencies)}")
+                label = ""
+
+            print(f"{'':<18} {'all':<7} {len(everything):5d} {'':>23} "
+                  f"{summary(everything)}")
+            print(f"{'':<18} {'behind':<7} {len(behind):5d} {'':>23} "
+                  f"{summary(behind)}  (keys pressed after it)")
+            if not args.no_hist and everything:
+                histogram(everything)
+            print()
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
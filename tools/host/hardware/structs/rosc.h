@@ -0,0 +1,16 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * hardware/structs/rosc.h - RP2040 ring oscillator for the host TFT
+ * renderer. randombit reads 0, the tool seeds the entropy pool itself.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t randombit;
+} rosc_hw_t;
+
+extern rosc_hw_t *rosc_hw;
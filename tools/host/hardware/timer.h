@@ -0,0 +1,19 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * hardware/timer.h - RP2040 1MHz timer for the host TFT renderer
+ *
+ * Follows the virtual clock, 1000us per ms, so the display's frame budget
+ * decisions are the same on every run.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t timerawh;
+    volatile uint32_t timerawl;
+} timer_hw_t;
+
+extern timer_hw_t *timer_hw;
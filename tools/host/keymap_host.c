@@ -0,0 +1,40 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * keymap_host.c - Keymap introspection for the host tools
+ *
+ * Same trick as QMK's keymap_introspection.c: #include the keymap so the
+ * sizes of keymaps[], key_combos[] and key_overrides[] are known here, and
+ * hand them to qmk_host.c through small accessors. KEYMAP_C is the keymap
+ * path, passed by the tool.
+ */
+
+#include KEYMAP_C
+
+uint8_t host_layer_count(void) { return ARRAY_SIZE(keymaps); }
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    if (layer >= ARRAY_SIZE(keymaps) || key.row >= MATRIX_ROWS ||
+        key.col >= MATRIX_COLS) {
+        return KC_NO;
+    }
+    return pgm_read_word(&keymaps[layer][key.row][key.col]);
+}
+
+#ifdef COMBO_ENABLE
+uint16_t combo_count(void) { return ARRAY_SIZE(key_combos); }
+
+combo_t *combo_get(uint16_t combo_idx) { return &key_combos[combo_idx]; }
+#else
+uint16_t combo_count(void) { return 0; }
+
+combo_t *combo_get(uint16_t combo_idx) { return NULL; }
+#endif
+
+#ifdef KEY_OVERRIDE_ENABLE
+const key_override_t *host_key_override(uint8_t index) {
+    return key_overrides[index]; // NULL terminated
+}
+#else
+const key_override_t *host_key_override(uint8_t index) { return NULL; }
+#endif
@@ -0,0 +1,25 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * process_leader.h - Leader key API for the host tools (see qmk_host.h)
+ */
+
+#pragma once
+
+#include "qmk_host.h"
+
+#ifndef LEADER_TIMEOUT
+#    define LEADER_TIMEOUT 300
+#endif
+
+void leader_start(void);
+void leader_end(void);
+bool leader_sequence_active(void);
+bool leader_sequence_timed_out(void);
+bool leader_sequence_one_key(uint16_t kc);
+bool leader_sequence_two_keys(uint16_t kc1, uint16_t kc2);
+bool leader_sequence_three_keys(uint16_t kc1, uint16_t kc2, uint16_t kc3);
+bool leader_sequence_four_keys(uint16_t kc1, uint16_t kc2, uint16_t kc3,
+                               uint16_t kc4);
+bool leader_sequence_five_keys(uint16_t kc1, uint16_t kc2, uint16_t kc3,
+                               uint16_t kc4, uint16_t kc5);
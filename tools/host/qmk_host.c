@@ -0,0 +1,1610 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * qmk_host.c - The QMK side of the host tools, plus their driver
+ *
+ * Runs the userspace (naughtyusername.c, numword.c, the keymap with
+ * keyrecords.c / combos.h) on a PC against a virtual clock. Key events come
+ * in on stdin, what the host would see goes out on stdout. tools/replay.py
+ * and tools/holdtap_bench.py build this and talk to it - see there for
+ * usage.
+ *
+ * An event goes through the same stages, in the same order, as in QMK:
+ *
+ *   pre_process_record_user()
+ *   combo engine        - buffers combo keys, fires or dumps them
+ *   tap-hold resolver   - tapping term, quick tap, Flow Tap, Chordal Hold,
+ *                         Permissive Hold, speculative hold
+ *   process_record      - Caps Word, key overrides, process_record_user(),
+ *                         Leader, then the keycode's action
+ *   post_process_record_user()
+ *
+ * Each stage is a small model of the QMK one, not a copy. They follow the
+ * documented behavior and only for the features this userspace uses: an
+ * option that isn't #defined in config.h doesn't exist here either. Where
+ * QMK has corner cases (combo key repeats, tap-hold keys inside combos held
+ * past the term, nested one-shots...) this may differ - confirm anything
+ * surprising on a board.
+ *
+ * stdin, one command per line:
+ *   p <ms> <row> <col>   key press at <ms>
+ *   r <ms> <row> <col>   key release at <ms>
+ *   t <ms>               let the clock run to <ms>
+ *   h <hex bytes>        raw HID packet to raw_hid_receive() (RAW_ENABLE)
+ *
+ * stdout:
+ *   R <ms> <mods> <keys...>          HID keyboard report (hex), on change
+ *   L <ms> <layer_state>             layer state (hex), on change
+ *   E <press> <emit> <row> <col> <keycode> <kind>
+ *                                    a key press reached the host: <kind>
+ *                                    is tap / hold (tap-hold keys), key, or
+ *                                    combo (eaten by a combo that fired)
+ *   H <hex bytes>                    raw_hid_send()
+ *
+ * `qmk_host --keys` prints the BASE layer instead: K <row> <col> <keycode>
+ * <tap keycode> <L|R hand> per position.
+ */
+
+#include "qmk_host.h"
+
+#include <stdio.h>
+
+#include "process_leader.h"
+
+// keymap_host.c
+uint8_t host_layer_count(void);
+const key_override_t *host_key_override(uint8_t index);
+
+#ifndef TAPPING_TERM
+#    define TAPPING_TERM 200
+#endif
+#ifndef QUICK_TAP_TERM
+#    define QUICK_TAP_TERM TAPPING_TERM
+#endif
+#ifndef COMBO_TERM
+#    define COMBO_TERM 50
+#endif
+#ifndef COMBO_HOLD_TERM
+#    define COMBO_HOLD_TERM TAPPING_TERM
+#endif
+#ifndef CAPS_WORD_IDLE_TIMEOUT
+#    define CAPS_WORD_IDLE_TIMEOUT 5000
+#endif
+
+// Keys that can queue up behind an undecided tap-hold key, as in QMK
+#define WAITING_BUFFER_SIZE 8
+
+/* ==========================================================================
+ * WEAK CALLBACKS
+ * ==========================================================================
+ * QMK's defaults, for anything the userspace doesn't define.
+ */
+__attribute__((weak)) bool pre_process_record_user(uint16_t keycode,
+                                                   keyrecord_t *record) {
+    return true;
+}
+__attribute__((weak)) bool process_record_user(uint16_t keycode,
+                                               keyrecord_t *record) {
+    return true;
+}
+__attribute__((weak)) void post_process_record_user(uint16_t keycode,
+                                                    keyrecord_t *record) {}
+__attribute__((weak)) layer_state_t layer_state_set_user(layer_state_t state) {
+    return state;
+}
+__attribute__((weak)) void matrix_scan_user(void) {}
+__attribute__((weak)) void housekeeping_task_user(void) {}
+__attribute__((weak)) void keyboard_post_init_user(void) {}
+__attribute__((weak)) void eeconfig_init_user(void) {}
+
+__attribute__((weak)) uint16_t get_tapping_term(uint16_t keycode,
+                                                keyrecord_t *record) {
+    return TAPPING_TERM;
+}
+__attribute__((weak)) uint16_t get_quick_tap_term(uint16_t keycode,
+                                                  keyrecord_t *record) {
+    return QUICK_TAP_TERM;
+}
+__attribute__((weak)) bool get_chordal_hold(uint16_t tap_hold_keycode,
+                                            keyrecord_t *tap_hold_record,
+                                            uint16_t other_keycode,
+                                            keyrecord_t *other_record) {
+    return get_chordal_hold_default(tap_hold_record, other_record);
+}
+__attribute__((weak)) bool is_flow_tap_key(uint16_t keycode) {
+    uint16_t tap = get_tap_keycode(keycode);
+    return (tap >= KC_A && tap <= KC_Z) || tap == KC_SPC;
+}
+__attribute__((weak)) uint16_t get_flow_tap_term(uint16_t keycode,
+                                                 keyrecord_t *record,
+                                                 uint16_t prev_keycode) {
+#ifdef FLOW_TAP_TERM
+    if (is_flow_tap_key(keycode) && is_flow_tap_key(prev_keycode)) {
+        return FLOW_TAP_TERM;
+    }
+#endif
+    return 0;
+}
+__attribute__((weak)) bool get_speculative_hold(uint16_t keycode,
+                                                keyrecord_t *record) {
+    return false;
+}
+
+__attribute__((weak)) void process_combo_event(uint16_t combo_index,
+                                               bool pressed) {}
+__attribute__((weak)) uint16_t get_combo_term(uint16_t combo_index,
+                                              combo_t *combo) {
+    return COMBO_TERM;
+}
+__attribute__((weak)) bool get_combo_must_hold(uint16_t combo_index,
+                                               combo_t *combo) {
+    return false;
+}
+__attribute__((weak)) bool get_combo_must_tap(uint16_t combo_index,
+                                              combo_t *combo) {
+    return false;
+}
+__attribute__((weak)) bool combo_should_trigger(uint16_t combo_index,
+                                                combo_t *combo,
+                                                uint16_t keycode,
+                                                keyrecord_t *record) {
+    return true;
+}
+
+__attribute__((weak)) void leader_start_user(void) {}
+__attribute__((weak)) void leader_end_user(void) {}
+
+/* ==========================================================================
+ * CLOCK
+ * ==========================================================================
+ */
+static uint32_t now_ms = 0;
+static uint32_t last_input_ms = 0;
+
+uint16_t timer_read(void) { return (uint16_t)now_ms; }
+uint32_t timer_read32(void) { return now_ms; }
+uint16_t timer_elapsed(uint16_t last) {
+    return TIMER_DIFF_16(timer_read(), last);
+}
+uint32_t timer_elapsed32(uint32_t last) {
+    return TIMER_DIFF_32(timer_read32(), last);
+}
+
+// Blocking waits don't move the virtual clock
+void wait_ms(uint32_t ms) {}
+
+uint32_t last_input_activity_elapsed(void) { return now_ms - last_input_ms; }
+
+/* ==========================================================================
+ * HID REPORT
+ * ==========================================================================
+ * 6KRO/NKRO doesn't matter to the tools - the report is a key bitmap. It's
+ * printed whenever it changes.
+ */
+static uint8_t real_mods = 0;
+static uint8_t weak_mods = 0;
+static uint8_t oneshot_mods = 0;
+static uint32_t oneshot_time = 0;
+static uint8_t suppressed_mods = 0; // Key override in effect
+static uint8_t key_bits[32];
+
+// Weak mods for the next key only (one-shot mods, Caps Word shift)
+static uint8_t next_key_mods = 0;
+static uint8_t ride_mods = 0;
+static uint8_t ride_code = KC_NO;
+
+static uint8_t sent_mods = 0;
+static uint8_t sent_bits[32];
+
+void send_keyboard_report(void) {
+    uint8_t mods = (real_mods | weak_mods | ride_mods) & ~suppressed_mods;
+    if (mods == sent_mods && memcmp(key_bits, sent_bits, sizeof(key_bits)) == 0) {
+        return;
+    }
+    sent_mods = mods;
+    memcpy(sent_bits, key_bits, sizeof(key_bits));
+
+    printf("R %u %02x", now_ms, mods);
+    for (uint16_t code = 0; code < 256; code++) {
+        if (key_bits[code >> 3] & (1 << (code & 7))) {
+            printf(" %02x", code);
+        }
+    }
+    printf("\n");
+}
+
+// 5-bit mod field (keycodes) to 8-bit HID mods
+static uint8_t mod_config(uint8_t mods) {
+    return (mods & 0x10) ? (uint8_t)((mods & 0x0F) << 4) : (mods & 0x0F);
+}
+
+void register_code(uint8_t code) {
+    if (code == KC_NO) {
+        return;
+    }
+    if (IS_MODIFIER_KEYCODE(code)) {
+        real_mods |= MOD_BIT(code);
+        send_keyboard_report();
+        return;
+    }
+
+    uint8_t mods = next_key_mods | oneshot_mods;
+    if (mods) {
+        ride_mods = mods;
+        ride_code = code;
+        next_key_mods = 0;
+        oneshot_mods = 0;
+    }
+    key_bits[code >> 3] |= 1 << (code & 7);
+    send_keyboard_report();
+}
+
+void unregister_code(uint8_t code) {
+    if (code == KC_NO) {
+        return;
+    }
+    if (IS_MODIFIER_KEYCODE(code)) {
+        real_mods &= ~MOD_BIT(code);
+        send_keyboard_report();
+        return;
+    }
+
+    key_bits[code >> 3] &= ~(1 << (code & 7));
+    if (code == ride_code) {
+        ride_mods = 0;
+        ride_code = KC_NO;
+    }
+    send_keyboard_report();
+}
+
+void tap_code(uint8_t code) {
+    register_code(code);
+    unregister_code(code);
+}
+
+void register_code16(uint16_t code) {
+    if (IS_QK_MODS(code)) {
+        weak_mods |= mod_config(QK_MODS_GET_MODS(code));
+        send_keyboard_report();
+    }
+    register_code(code & 0xFF);
+}
+
+void unregister_code16(uint16_t code) {
+    unregister_code(code & 0xFF);
+    if (IS_QK_MODS(code)) {
+        weak_mods &= ~mod_config(QK_MODS_GET_MODS(code));
+        send_keyboard_report();
+    }
+}
+
+void tap_code16(uint16_t code) {
+    register_code16(code);
+    unregister_code16(code);
+}
+
+uint8_t get_mods(void) { return real_mods; }
+void add_mods(uint8_t mods) { real_mods |= mods; }
+void del_mods(uint8_t mods) { real_mods &= ~mods; }
+void set_mods(uint8_t mods) { real_mods = mods; }
+void clear_mods(void) { real_mods = 0; }
+
+void register_mods(uint8_t mods) {
+    real_mods |= mods;
+    send_keyboard_report();
+}
+
+void unregister_mods(uint8_t mods) {
+    real_mods &= ~mods;
+    send_keyboard_report();
+}
+
+uint8_t get_oneshot_mods(void) { return oneshot_mods; }
+
+void add_oneshot_mods(uint8_t mods) {
+    oneshot_mods |= mods;
+    oneshot_time = now_ms;
+}
+
+void clear_oneshot_mods(void) { oneshot_mods = 0; }
+
+/* ==========================================================================
+ * SEND STRING
+ * ==========================================================================
+ * US layout, like QMK's default send_string keymap.
+ */
+static uint16_t ascii_keycode(char c) {
+    if (c >= 'a' && c <= 'z') {
+        return KC_A + (c - 'a');
+    }
+    if (c >= 'A' && c <= 'Z') {
+        return S(KC_A + (c - 'A'));
+    }
+    if (c >= '1' && c <= '9') {
+        return KC_1 + (c - '1');
+    }
+    switch (c) {
+    case '0': return KC_0;
+    case '\n': return KC_ENT;
+    case '\t': return KC_TAB;
+    case '\b': return KC_BSPC;
+    case 0x1B: return KC_ESC;
+    case ' ': return KC_SPC;
+    case '!': return KC_EXLM;
+    case '"': return KC_DQUO;
+    case '#': return KC_HASH;
+    case '$': return KC_DLR;
+    case '%': return KC_PERC;
+    case '&': return KC_AMPR;
+    case '\'': return KC_QUOT;
+    case '(': return KC_LPRN;
+    case ')': return KC_RPRN;
+    case '*': return KC_ASTR;
+    case '+': return KC_PLUS;
+    case ',': return KC_COMM;
+    case '-': return KC_MINS;
+    case '.': return KC_DOT;
+    case '/': return KC_SLSH;
+    case ':': return KC_COLN;
+    case ';': return KC_SCLN;
+    case '<': return KC_LT;
+    case '=': return KC_EQL;
+    case '>': return KC_GT;
+    case '?': return KC_QUES;
+    case '@': return KC_AT;
+    case '[': return KC_LBRC;
+    case '\\': return KC_BSLS;
+    case ']': return KC_RBRC;
+    case '^': return KC_CIRC;
+    case '_': return KC_UNDS;
+    case '`': return KC_GRV;
+    case '{': return KC_LCBR;
+    case '|': return KC_PIPE;
+    case '}': return KC_RCBR;
+    case '~': return KC_TILD;
+    default: return KC_NO;
+    }
+}
+
+void send_char(char ascii_code) { tap_code16(ascii_keycode(ascii_code)); }
+
+void send_string(const char *string) {
+    while (*string) {
+        char c = *string++;
+        if (c == SS_TAP_CODE || c == SS_DOWN_CODE || c == SS_UP_CODE) {
+            uint8_t code = (uint8_t)*string++;
+            if (code == 0) {
+                break;
+            }
+            if (c == SS_TAP_CODE) {
+                tap_code(code);
+            } else if (c == SS_DOWN_CODE) {
+                register_code(code);
+            } else {
+                unregister_code(code);
+            }
+            continue;
+        }
+        send_char(c);
+    }
+}
+
+void send_string_P(const char *string) { send_string(string); }
+
+const char *get_u16_str(uint16_t curr_num, char curr_pad) {
+    static char buf[6];
+    snprintf(buf, sizeof(buf), "%5u", curr_num);
+    for (char *p = buf; *p == ' '; p++) {
+        *p = curr_pad;
+    }
+    return buf;
+}
+
+/* ==========================================================================
+ * LAYERS
+ * ==========================================================================
+ */
+layer_state_t layer_state = 0;
+layer_state_t default_layer_state = 1;
+
+static void layer_state_set(layer_state_t state) {
+    state = layer_state_set_user(state);
+    if (state != layer_state) {
+        layer_state = state;
+        printf("L %u %08x\n", now_ms, layer_state);
+    }
+}
+
+bool layer_state_cmp(layer_state_t state, uint8_t layer) {
+    if (!state) {
+        return layer == 0;
+    }
+    return (state & ((layer_state_t)1 << layer)) != 0;
+}
+
+bool layer_state_is(uint8_t layer) { return layer_state_cmp(layer_state, layer); }
+
+void layer_on(uint8_t layer) {
+    layer_state_set(layer_state | ((layer_state_t)1 << layer));
+}
+
+void layer_off(uint8_t layer) {
+    layer_state_set(layer_state & ~((layer_state_t)1 << layer));
+}
+
+void layer_move(uint8_t layer) { layer_state_set((layer_state_t)1 << layer); }
+
+void layer_invert(uint8_t layer) {
+    layer_state_set(layer_state ^ ((layer_state_t)1 << layer));
+}
+
+void layer_clear(void) { layer_state_set(0); }
+
+uint8_t get_highest_layer(layer_state_t state) {
+    for (int8_t i = 31; i > 0; i--) {
+        if (state & ((layer_state_t)1 << i)) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+layer_state_t update_tri_layer_state(layer_state_t state, uint8_t layer1,
+                                     uint8_t layer2, uint8_t layer3) {
+    layer_state_t mask12 =
+        ((layer_state_t)1 << layer1) | ((layer_state_t)1 << layer2);
+    layer_state_t mask3 = (layer_state_t)1 << layer3;
+    return (state & mask12) == mask12 ? (state | mask3) : (state & ~mask3);
+}
+
+// Layer a press reads its keycode from, remembered for the release
+static uint8_t source_layers[MATRIX_ROWS][MATRIX_COLS];
+
+static uint8_t layer_switch_get_layer(keypos_t key) {
+    layer_state_t layers = layer_state | default_layer_state;
+    for (int8_t i = 31; i >= 0; i--) {
+        if (i < host_layer_count() && (layers & ((layer_state_t)1 << i)) &&
+            keymap_key_to_keycode(i, key) != KC_TRNS) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+static uint16_t record_keycode(keyrecord_t *record, bool update_cache) {
+    if (!IS_KEYEVENT(record->event)) {
+        return record->keycode;
+    }
+
+    keypos_t key = record->event.key;
+    uint8_t layer;
+    if (record->event.pressed) {
+        layer = layer_switch_get_layer(key);
+        if (update_cache) {
+            source_layers[key.row][key.col] = layer;
+        }
+    } else {
+        layer = source_layers[key.row][key.col];
+    }
+    return keymap_key_to_keycode(layer, key);
+}
+
+/* ==========================================================================
+ * MISC QMK STATE
+ * ==========================================================================
+ */
+led_t host_keyboard_led_state(void) { return (led_t){.raw = 0}; }
+bool is_keyboard_master(void) { return true; }
+bool is_keyboard_left(void) { return true; }
+uint8_t get_current_wpm(void) { return 0; }
+
+uint16_t get_tap_keycode(uint16_t keycode) {
+    if (IS_QK_MOD_TAP(keycode)) {
+        return QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+    }
+    if (IS_QK_LAYER_TAP(keycode)) {
+        return QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+    }
+    return keycode;
+}
+
+// Split boards: the left half is the first MATRIX_ROWS / 2 rows
+static char host_handedness(keypos_t key) {
+    return key.row < MATRIX_ROWS / 2 ? 'L' : 'R';
+}
+
+bool get_chordal_hold_default(keyrecord_t *tap_hold_record,
+                              keyrecord_t *other_record) {
+    if (!IS_KEYEVENT(tap_hold_record->event) ||
+        !IS_KEYEVENT(other_record->event)) {
+        return true; // Combos and other synthetic events
+    }
+    return host_handedness(tap_hold_record->event.key) !=
+           host_handedness(other_record->event.key);
+}
+
+/* ==========================================================================
+ * RAW HID / EEPROM
+ * ==========================================================================
+ */
+void raw_hid_send(uint8_t *data, uint8_t length) {
+    printf("H");
+    for (uint8_t i = 0; i < length; i++) {
+        printf(" %02x", data[i]);
+    }
+    printf("\n");
+}
+
+#ifdef EECONFIG_USER_DATA_SIZE
+static uint8_t user_datablock[EECONFIG_USER_DATA_SIZE];
+#else
+static uint8_t user_datablock[1];
+#endif
+static bool user_datablock_valid = false;
+
+void eeconfig_read_user_datablock(void *data, uint32_t offset,
+                                  uint32_t length) {
+    if (offset + length <= sizeof(user_datablock)) {
+        memcpy(data, &user_datablock[offset], length);
+    }
+}
+
+void eeconfig_update_user_datablock(const void *data, uint32_t offset,
+                                    uint32_t length) {
+    if (offset + length <= sizeof(user_datablock)) {
+        memcpy(&user_datablock[offset], data, length);
+    }
+}
+
+bool eeconfig_is_user_datablock_valid(void) { return user_datablock_valid; }
+
+void eeconfig_init_user_datablock(void) {
+    memset(user_datablock, 0, sizeof(user_datablock));
+    user_datablock_valid = true;
+}
+
+/* ==========================================================================
+ * CAPS WORD
+ * ==========================================================================
+ * QMK's default caps_word_press_user(): letters and - get shifted, digits,
+ * Backspace, Delete and _ keep the word going, anything else ends it.
+ */
+static bool caps_word_active = false;
+static uint32_t caps_word_time = 0;
+
+bool is_caps_word_on(void) { return caps_word_active; }
+
+void caps_word_on(void) {
+    caps_word_active = true;
+    caps_word_time = now_ms;
+}
+
+void caps_word_off(void) { caps_word_active = false; }
+
+void caps_word_toggle(void) {
+    if (caps_word_active) {
+        caps_word_off();
+    } else {
+        caps_word_on();
+    }
+}
+
+static void process_caps_word(uint16_t keycode, keyrecord_t *record) {
+    if (!caps_word_active || !record->event.pressed || keycode == CW_TOGG) {
+        return;
+    }
+
+    // Held tap-hold keys, layer keys and mods don't end the word
+    if (IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode)) {
+        if (record->tap.count == 0) {
+            return;
+        }
+        keycode = get_tap_keycode(keycode);
+    } else if ((keycode >= QK_TO && keycode <= QK_ONE_SHOT_MOD_MAX) ||
+               IS_MODIFIER_KEYCODE(keycode)) {
+        return;
+    }
+
+    if ((get_mods() | get_oneshot_mods()) & ~MOD_MASK_SHIFT) {
+        caps_word_off();
+        return;
+    }
+
+    caps_word_time = now_ms;
+    switch (keycode) {
+    case KC_A ... KC_Z:
+    case KC_MINS:
+        next_key_mods |= MOD_BIT(KC_LSFT);
+        break;
+    case KC_1 ... KC_0:
+    case KC_BSPC:
+    case KC_DEL:
+    case KC_UNDS:
+        break;
+    default:
+        caps_word_off();
+        break;
+    }
+}
+
+/* ==========================================================================
+ * KEY OVERRIDES
+ * ==========================================================================
+ * Basic overrides only: trigger key + any of the trigger mods sends the
+ * replacement with those mods taken out of the report.
+ */
+static uint16_t override_trigger = KC_NO;
+static uint16_t override_replacement = KC_NO;
+
+static bool process_key_override(uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed) {
+        if (override_trigger == KC_NO || keycode != override_trigger) {
+            return true;
+        }
+        suppressed_mods = 0;
+        unregister_code16(override_replacement);
+        override_trigger = KC_NO;
+        return false;
+    }
+
+    uint8_t mods = get_mods() | get_oneshot_mods();
+    const key_override_t *override;
+    for (uint8_t i = 0; (override = host_key_override(i)) != NULL; i++) {
+        if (override->trigger != keycode ||
+            (mods & override->trigger_mods) == 0) {
+            continue;
+        }
+        override_trigger = keycode;
+        override_replacement = override->replacement;
+        suppressed_mods = mods & override->trigger_mods;
+        oneshot_mods &= ~suppressed_mods;
+        register_code16(override_replacement);
+        return false;
+    }
+    return true;
+}
+
+/* ==========================================================================
+ * LEADER
+ * ==========================================================================
+ */
+static bool leader_active = false;
+static uint16_t leader_sequence[5];
+static uint8_t leader_length = 0;
+static uint32_t leader_time = 0;
+
+void leader_start(void) {
+    if (leader_active) {
+        return;
+    }
+    leader_active = true;
+    leader_length = 0;
+    memset(leader_sequence, 0, sizeof(leader_sequence));
+    leader_time = now_ms;
+    leader_start_user();
+}
+
+void leader_end(void) {
+    leader_active = false;
+    leader_end_user();
+}
+
+bool leader_sequence_active(void) { return leader_active; }
+
+bool leader_sequence_timed_out(void) {
+    return now_ms - leader_time > LEADER_TIMEOUT;
+}
+
+static bool leader_sequence_is(uint16_t kc1, uint16_t kc2, uint16_t kc3,
+                               uint16_t kc4, uint16_t kc5) {
+    return leader_sequence[0] == kc1 && leader_sequence[1] == kc2 &&
+           leader_sequence[2] == kc3 && leader_sequence[3] == kc4 &&
+           leader_sequence[4] == kc5;
+}
+
+bool leader_sequence_one_key(uint16_t kc) {
+    return leader_sequence_is(kc, 0, 0, 0, 0);
+}
+
+bool leader_sequence_two_keys(uint16_t kc1, uint16_t kc2) {
+    return leader_sequence_is(kc1, kc2, 0, 0, 0);
+}
+
+bool leader_sequence_three_keys(uint16_t kc1, uint16_t kc2, uint16_t kc3) {
+    return leader_sequence_is(kc1, kc2, kc3, 0, 0);
+}
+
+bool leader_sequence_four_keys(uint16_t kc1, uint16_t kc2, uint16_t kc3,
+                               uint16_t kc4) {
+    return leader_sequence_is(kc1, kc2, kc3, kc4, 0);
+}
+
+bool leader_sequence_five_keys(uint16_t kc1, uint16_t kc2, uint16_t kc3,
+                               uint16_t kc4, uint16_t kc5) {
+    return leader_sequence_is(kc1, kc2, kc3, kc4, kc5);
+}
+
+static bool process_leader(uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed) {
+        return true;
+    }
+    if (leader_active && !leader_sequence_timed_out()) {
+        keycode = get_tap_keycode(keycode);
+        if (leader_length == ARRAY_SIZE(leader_sequence)) {
+            leader_end();
+            return true;
+        }
+        leader_sequence[leader_length++] = keycode;
+#ifdef LEADER_PER_KEY_TIMING
+        leader_time = now_ms;
+#endif
+        return false;
+    }
+    if (keycode == QK_LEADER) {
+        leader_start();
+    }
+    return true;
+}
+
+/* ==========================================================================
+ * PROCESS RECORD
+ * ==========================================================================
+ * A decided event: QMK's process_record() down to the keycode's action.
+ */
+static uint8_t tap_counts[MATRIX_ROWS][MATRIX_COLS];
+static bool speculated[MATRIX_ROWS][MATRIX_COLS];
+static uint32_t speculated_at[MATRIX_ROWS][MATRIX_COLS];
+
+static uint16_t repeat_keycode = KC_NO;
+static uint16_t repeat_held = KC_NO;
+
+static uint8_t osm_held = 0;
+static bool osm_interrupted = false;
+static uint8_t osl_layer = 0xFF;
+static bool osl_interrupted = false;
+static bool osl_armed = false;
+
+// Event times are 16 bit like QMK's, the E lines want the full clock
+static uint32_t press_time(keyrecord_t *record) {
+    return now_ms - TIMER_DIFF_16((uint16_t)now_ms, record->event.time);
+}
+
+static bool is_tap_hold(uint16_t keycode) {
+    return IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode);
+}
+
+static void process_action(uint16_t keycode, keyrecord_t *record) {
+    bool pressed = record->event.pressed;
+
+    if (keycode <= KC_TRNS) {
+        return;
+    }
+    if (IS_QK_BASIC(keycode) || IS_QK_MODS(keycode)) {
+        if (pressed) {
+            register_code16(keycode);
+        } else {
+            unregister_code16(keycode);
+        }
+        return;
+    }
+    if (is_tap_hold(keycode) && record->tap.count > 0) {
+        if (pressed) {
+            register_code(get_tap_keycode(keycode));
+        } else {
+            unregister_code(get_tap_keycode(keycode));
+        }
+        return;
+    }
+    if (IS_QK_MOD_TAP(keycode)) {
+        uint8_t mods = mod_config(QK_MOD_TAP_GET_MODS(keycode));
+        if (pressed) {
+            register_mods(mods);
+        } else {
+            unregister_mods(mods);
+        }
+        return;
+    }
+    if (IS_QK_LAYER_TAP(keycode)) {
+        if (pressed) {
+            layer_on(QK_LAYER_TAP_GET_LAYER(keycode));
+        } else {
+            layer_off(QK_LAYER_TAP_GET_LAYER(keycode));
+        }
+        return;
+    }
+
+    uint8_t arg = keycode & 0x1F;
+    switch (keycode & ~0x1F) {
+    case QK_TO:
+        if (pressed) {
+            layer_move(arg);
+        }
+        return;
+    case QK_MOMENTARY:
+        if (pressed) {
+            layer_on(arg);
+        } else {
+            layer_off(arg);
+        }
+        return;
+    case QK_DEF_LAYER:
+        if (pressed) {
+            default_layer_state = (layer_state_t)1 << arg;
+        }
+        return;
+    case QK_TOGGLE_LAYER:
+        if (pressed) {
+            layer_invert(arg);
+        }
+        return;
+    case QK_ONE_SHOT_LAYER:
+        // Tapped: on until the next key. Held: plain momentary layer.
+        if (pressed) {
+            osl_layer = arg;
+            osl_interrupted = false;
+            osl_armed = false;
+            layer_on(arg);
+        } else if (osl_interrupted) {
+            layer_off(arg);
+            osl_layer = 0xFF;
+        } else {
+            osl_armed = true;
+        }
+        return;
+    case QK_ONE_SHOT_MOD:
+        // Tapped: applies to the next key. Held: plain modifier.
+        if (pressed) {
+            osm_held |= mod_config(arg);
+            osm_interrupted = false;
+            register_mods(mod_config(arg));
+        } else {
+            osm_held &= ~mod_config(arg);
+            unregister_mods(mod_config(arg));
+            if (!osm_interrupted) {
+                add_oneshot_mods(mod_config(arg));
+            }
+        }
+        return;
+    }
+
+    if (keycode == CW_TOGG && pressed) {
+        caps_word_toggle();
+    }
+}
+
+static void process_record(keyrecord_t *record) {
+    uint16_t keycode = record_keycode(record, true);
+    bool pressed = record->event.pressed;
+
+    if (IS_KEYEVENT(record->event) && pressed) {
+        keypos_t key = record->event.key;
+        const char *kind = "key";
+        uint32_t emit = now_ms;
+        if (is_tap_hold(keycode)) {
+            kind = record->tap.count > 0 ? "tap" : "hold";
+            if (record->tap.count == 0 && speculated[key.row][key.col]) {
+                emit = speculated_at[key.row][key.col]; // Mods went out early
+            }
+        }
+        printf("E %u %u %u %u %04x %s\n", press_time(record), emit, key.row,
+               key.col, keycode, kind);
+    }
+
+    // Repeat Key: the last key again
+    if (keycode == QK_REP) {
+        if (pressed) {
+            repeat_held = repeat_keycode;
+        }
+        keycode = repeat_held;
+        if (keycode == KC_NO) {
+            return;
+        }
+    } else if (pressed) {
+        if (IS_QK_BASIC(keycode) || IS_QK_MODS(keycode)) {
+            repeat_keycode = keycode;
+        } else if (is_tap_hold(keycode) && record->tap.count > 0) {
+            repeat_keycode = get_tap_keycode(keycode);
+        }
+    }
+
+    bool is_osm = (keycode & ~0x1F) == QK_ONE_SHOT_MOD;
+    bool is_osl = (keycode & ~0x1F) == QK_ONE_SHOT_LAYER;
+    if (pressed && !is_osm) {
+        osm_interrupted = true;
+    }
+    if (pressed && !is_osl) {
+        osl_interrupted = true;
+    }
+
+    process_caps_word(keycode, record);
+    if (process_key_override(keycode, record) &&
+        process_record_user(keycode, record) &&
+        process_leader(keycode, record)) {
+        process_action(keycode, record);
+    }
+    post_process_record_user(keycode, record);
+    next_key_mods = 0;
+
+    // A tapped one-shot layer lasts for one key
+    if (pressed && !is_osl && osl_armed) {
+        layer_off(osl_layer);
+        osl_armed = false;
+        osl_layer = 0xFF;
+    }
+}
+
+/* ==========================================================================
+ * TAP-HOLD RESOLVER
+ * ==========================================================================
+ * One undecided tap-hold key at a time, everything pressed after it waits.
+ * It is decided by:
+ *
+ *   quick tap        pressed again within get_quick_tap_term() of its last
+ *                    tap → tap
+ *   Flow Tap         pressed within get_flow_tap_term() of the previous
+ *                    key → tap
+ *   released         before the tapping term → tap
+ *   Chordal Hold     another key pressed and get_chordal_hold() says no
+ *                    (same hand) → tap
+ *   Permissive Hold  another key pressed and released → hold
+ *   tapping term     get_tapping_term() runs out → hold
+ */
+static bool tapping_pending = false;
+static keyrecord_t tapping_key;
+static uint16_t tapping_keycode = KC_NO;
+static uint8_t tapping_spec_mods = 0;
+
+static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE];
+static uint8_t waiting_count = 0;
+
+// Last tap, for quick tap
+static bool last_tap_valid = false;
+static keypos_t last_tap_key;
+static uint16_t last_tap_keycode = KC_NO;
+static uint16_t last_tap_time = 0;
+static uint8_t last_tap_count = 0;
+
+// Previous press, for Flow Tap
+static uint16_t flow_prev_keycode = KC_NO;
+static uint16_t flow_prev_time = 0;
+
+static bool same_key(keyrecord_t *a, keyrecord_t *b) {
+    return IS_KEYEVENT(a->event) && IS_KEYEVENT(b->event) &&
+           a->event.key.row == b->event.key.row &&
+           a->event.key.col == b->event.key.col;
+}
+
+static void tapping_process(keyrecord_t *record);
+
+static void tapping_settle(keyrecord_t *record, uint8_t tap_count) {
+    keypos_t key = record->event.key;
+    record->tap.count = tap_count;
+    tap_counts[key.row][key.col] = tap_count;
+    process_record(record);
+}
+
+static void tapping_resolve(bool tap) {
+    keyrecord_t record = tapping_key;
+    keypos_t key = record.event.key;
+
+    tapping_pending = false;
+    if (tapping_spec_mods && tap) {
+        unregister_mods(tapping_spec_mods);
+        speculated[key.row][key.col] = false;
+    }
+    tapping_spec_mods = 0;
+    tapping_settle(&record, tap ? 1 : 0);
+
+    // Replay what queued up behind the key, in order
+    keyrecord_t queued[WAITING_BUFFER_SIZE];
+    uint8_t count = waiting_count;
+    memcpy(queued, waiting_buffer, sizeof(queued));
+    waiting_count = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        tapping_process(&queued[i]);
+    }
+}
+
+// The newest waiting event may decide the pending key
+static void tapping_check(keyrecord_t *event) {
+    if (same_key(event, &tapping_key)) {
+        if (!event->event.pressed) {
+            tapping_resolve(true);
+        }
+        return;
+    }
+
+    if (event->event.pressed) {
+#ifdef CHORDAL_HOLD
+        uint16_t other_keycode = record_keycode(event, false);
+        if (!get_chordal_hold(tapping_keycode, &tapping_key, other_keycode,
+                              event)) {
+            tapping_resolve(true);
+        }
+#endif
+        return;
+    }
+
+#ifdef PERMISSIVE_HOLD
+    for (uint8_t i = 0; i + 1 < waiting_count; i++) {
+        if (waiting_buffer[i].event.pressed &&
+            same_key(&waiting_buffer[i], event)) {
+            tapping_resolve(false);
+            return;
+        }
+    }
+#endif
+}
+
+static void tapping_begin(keyrecord_t *record, uint16_t keycode) {
+    keypos_t key = record->event.key;
+
+    // Quick tap: the same key again soon after its tap repeats the tap
+    if (last_tap_valid && last_tap_key.row == key.row &&
+        last_tap_key.col == key.col && last_tap_keycode == keycode &&
+        TIMER_DIFF_16(record->event.time, last_tap_time) <
+            get_quick_tap_term(keycode, record)) {
+        flow_prev_keycode = keycode;
+        flow_prev_time = record->event.time;
+        tapping_settle(record, MIN(last_tap_count + 1, 15));
+        return;
+    }
+    last_tap_valid = false;
+
+#ifdef FLOW_TAP_TERM
+    uint16_t flow_term = get_flow_tap_term(keycode, record, flow_prev_keycode);
+    bool flow = flow_term > 0 &&
+                TIMER_DIFF_16(record->event.time, flow_prev_time) < flow_term;
+    flow_prev_keycode = keycode;
+    flow_prev_time = record->event.time;
+    if (flow) {
+        tapping_settle(record, 1);
+        return;
+    }
+#endif
+
+    tapping_pending = true;
+    tapping_key = *record;
+    tapping_key.tap.count = 0;
+    tapping_keycode = keycode;
+
+#ifdef SPECULATIVE_HOLD
+    if (IS_QK_MOD_TAP(keycode) && get_speculative_hold(keycode, record)) {
+        tapping_spec_mods = mod_config(QK_MOD_TAP_GET_MODS(keycode));
+        speculated[key.row][key.col] = true;
+        speculated_at[key.row][key.col] = now_ms;
+        register_mods(tapping_spec_mods);
+    }
+#endif
+}
+
+static void tapping_process(keyrecord_t *record) {
+    if (tapping_pending) {
+        if (waiting_count == WAITING_BUFFER_SIZE) {
+            fprintf(stderr, "qmk_host: waiting buffer full at %u ms\n",
+                    now_ms);
+            tapping_resolve(false);
+            tapping_process(record);
+            return;
+        }
+        waiting_buffer[waiting_count++] = *record;
+        tapping_check(&waiting_buffer[waiting_count - 1]);
+        return;
+    }
+
+    uint16_t keycode = record_keycode(record, false);
+    if (!IS_KEYEVENT(record->event)) {
+        if (record->event.pressed) {
+            last_tap_valid = false;
+        }
+        process_record(record);
+        return;
+    }
+
+    keypos_t key = record->event.key;
+    if (record->event.pressed) {
+        if (is_tap_hold(keycode)) {
+            tapping_begin(record, keycode);
+            return;
+        }
+        last_tap_valid = false;
+        if (!IS_MODIFIER_KEYCODE(keycode)) {
+            flow_prev_keycode = keycode;
+            flow_prev_time = record->event.time;
+        }
+        record->tap.count = 0;
+        process_record(record);
+        return;
+    }
+
+    // Release: same tap count as the press
+    record->tap.count = tap_counts[key.row][key.col];
+    if (record->tap.count > 0 && is_tap_hold(keycode)) {
+        last_tap_valid = true;
+        last_tap_key = key;
+        last_tap_keycode = keycode;
+        last_tap_time = record->event.time;
+        last_tap_count = record->tap.count;
+    }
+    tap_counts[key.row][key.col] = 0;
+    speculated[key.row][key.col] = false;
+    process_record(record);
+}
+
+static void tapping_task(void) {
+    if (tapping_pending &&
+        TIMER_DIFF_16(timer_read(), tapping_key.event.time) >=
+            get_tapping_term(tapping_keycode, &tapping_key)) {
+        tapping_resolve(false);
+    }
+}
+
+/* ==========================================================================
+ * COMBO ENGINE
+ * ==========================================================================
+ * Combo keys are matched on the BASE layer (COMBO_ONLY_FROM_LAYER). A press
+ * that can still be part of a combo is held back. The chord is settled when
+ * a key outside every candidate combo is pressed, a held-back key is
+ * released, or the wait runs out - the longest get_combo_term() of the
+ * candidates, COMBO_HOLD_TERM for must-hold / must-tap ones. Then the
+ * biggest complete combo fires (all its keys pressed within its term) and
+ * the rest of the held-back keys go on as normal presses. Must-hold combos
+ * only fire at the end of the wait, must-tap ones only before it.
+ *
+ * combo_t's state / disabled / active are kept the way QMK keeps them, for
+ * userspace that reads them (combo_early.c).
+ */
+#ifdef COMBO_ENABLE
+#    define HOST_COMBOS_MAX 256
+#    define HOST_ACTIVE_COMBOS 4
+
+static keyrecord_t combo_buffer[COMBO_KEY_BUFFER_LENGTH];
+static uint16_t combo_buffer_keycodes[COMBO_KEY_BUFFER_LENGTH];
+static uint8_t combo_buffer_count = 0;
+static uint16_t combo_timer = 0;
+static bool combo_candidates[HOST_COMBOS_MAX];
+
+typedef struct {
+    bool used;
+    bool released;
+    uint16_t index;
+    keypos_t keys[COMBO_KEY_BUFFER_LENGTH];
+    uint8_t count;
+} active_combo_t;
+static active_combo_t active_combos[HOST_ACTIVE_COMBOS];
+
+enum combo_settle_reason {
+    COMBO_SETTLE_PRESS,
+    COMBO_SETTLE_RELEASE,
+    COMBO_SETTLE_TIMEOUT,
+};
+
+static uint16_t combo_base_keycode(keyrecord_t *record) {
+    return keymap_key_to_keycode(0, record->event.key);
+}
+
+static uint8_t combo_key_count(const combo_t *combo) {
+    uint8_t count = 0;
+    while (pgm_read_word(&combo->keys[count]) != COMBO_END) {
+        count++;
+    }
+    return count;
+}
+
+static bool combo_has_key(const combo_t *combo, uint16_t keycode) {
+    for (uint8_t i = 0; pgm_read_word(&combo->keys[i]) != COMBO_END; i++) {
+        if (pgm_read_word(&combo->keys[i]) == keycode) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Every key of the combo held back, pressed within its term
+static bool combo_is_complete(uint16_t index) {
+    combo_t *combo = combo_get(index);
+    uint8_t count = combo_key_count(combo);
+    uint16_t first = 0, last = 0;
+    uint8_t found = 0;
+
+    for (uint8_t k = 0; k < combo_buffer_count; k++) {
+        if (!combo_has_key(combo, combo_buffer_keycodes[k])) {
+            continue;
+        }
+        uint16_t time = combo_buffer[k].event.time;
+        if (found == 0) {
+            first = time;
+        }
+        last = time;
+        found++;
+    }
+    return found == count &&
+           TIMER_DIFF_16(last, first) < get_combo_term(index, combo);
+}
+
+// Key bits of the candidates from the held-back keys; a complete one that
+// was too slow is disabled. Fired combos keep theirs until let go.
+static void combo_update_state(void) {
+    for (uint16_t i = 0; i < combo_count(); i++) {
+        combo_t *combo = combo_get(i);
+        if (combo->active) {
+            continue;
+        }
+        combo->state = 0;
+        combo->disabled = false;
+        if (!combo_candidates[i]) {
+            continue;
+        }
+        for (uint8_t k = 0; k < combo_key_count(combo); k++) {
+            uint16_t key = pgm_read_word(&combo->keys[k]);
+            for (uint8_t b = 0; b < combo_buffer_count; b++) {
+                if (combo_buffer_keycodes[b] == key) {
+                    combo->state |= 1 << k;
+                }
+            }
+        }
+        combo->disabled = combo->state == (1 << combo_key_count(combo)) - 1 &&
+                          !combo_is_complete(i);
+    }
+}
+
+// Hold back the press if it and the held-back keys can still make a combo
+static bool combo_try_buffer(keyrecord_t *record, uint16_t keycode) {
+    if (combo_buffer_count == COMBO_KEY_BUFFER_LENGTH) {
+        return false;
+    }
+
+    bool any = false;
+    bool candidates[HOST_COMBOS_MAX];
+    for (uint16_t i = 0; i < combo_count(); i++) {
+        combo_t *combo = combo_get(i);
+        candidates[i] = false;
+        if (!combo_has_key(combo, keycode)) {
+            continue;
+        }
+        bool fits = true;
+        for (uint8_t k = 0; k < combo_buffer_count && fits; k++) {
+            fits = combo_has_key(combo, combo_buffer_keycodes[k]);
+        }
+#    ifdef COMBO_SHOULD_TRIGGER
+        fits = fits && combo_should_trigger(i, combo, keycode, record);
+#    endif
+        candidates[i] = fits;
+        any = any || fits;
+    }
+    if (!any) {
+        return false;
+    }
+
+    memcpy(combo_candidates, candidates, sizeof(combo_candidates));
+    combo_buffer[combo_buffer_count] = *record;
+    combo_buffer_keycodes[combo_buffer_count] = keycode;
+    combo_buffer_count++;
+    combo_timer = record->event.time;
+    combo_update_state();
+    return true;
+}
+
+static uint16_t combo_wait(void) {
+    uint16_t wait = 0;
+    for (uint16_t i = 0; i < combo_count(); i++) {
+        if (!combo_candidates[i]) {
+            continue;
+        }
+        combo_t *combo = combo_get(i);
+        uint16_t term = get_combo_term(i, combo);
+        if (get_combo_must_hold(i, combo) || get_combo_must_tap(i, combo)) {
+            term = MAX(term, COMBO_HOLD_TERM);
+        }
+        wait = MAX(wait, term);
+    }
+    return wait;
+}
+
+static void combo_fire(uint16_t index) {
+    combo_t *combo = combo_get(index);
+    active_combo_t *active = NULL;
+    for (uint8_t i = 0; i < HOST_ACTIVE_COMBOS; i++) {
+        if (!active_combos[i].used) {
+            active = &active_combos[i];
+            break;
+        }
+    }
+    if (active == NULL) {
+        fprintf(stderr, "qmk_host: too many combos held at %u ms\n", now_ms);
+        return;
+    }
+
+    active->used = true;
+    active->released = false;
+    active->index = index;
+    active->count = 0;
+    combo->active = true;
+
+    // Take the combo's keys out of the buffer
+    uint8_t kept = 0;
+    for (uint8_t k = 0; k < combo_buffer_count; k++) {
+        keyrecord_t *record = &combo_buffer[k];
+        if (combo_has_key(combo, combo_buffer_keycodes[k])) {
+            active->keys[active->count++] = record->event.key;
+            printf("E %u %u %u %u %04x combo\n", press_time(record), now_ms,
+                   record->event.key.row, record->event.key.col,
+                   combo_buffer_keycodes[k]);
+            continue;
+        }
+        combo_buffer[kept] = *record;
+        combo_buffer_keycodes[kept] = combo_buffer_keycodes[k];
+        kept++;
+    }
+    combo_buffer_count = kept;
+
+    if (combo->keycode != KC_NO) {
+        keyrecord_t record = {
+            .event = {.key = {.col = 254, .row = 254},
+                      .time = timer_read(),
+                      .type = COMBO_EVENT,
+                      .pressed = true},
+            .keycode = combo->keycode,
+        };
+        tapping_process(&record);
+    }
+    process_combo_event(index, true);
+}
+
+static void combo_settle(enum combo_settle_reason reason) {
+    int16_t best = -1;
+    uint8_t best_size = 0;
+
+    for (uint16_t i = 0; i < combo_count(); i++) {
+        if (!combo_candidates[i] || !combo_is_complete(i)) {
+            continue;
+        }
+        combo_t *combo = combo_get(i);
+        if (get_combo_must_hold(i, combo) && reason != COMBO_SETTLE_TIMEOUT) {
+            continue;
+        }
+        if (get_combo_must_tap(i, combo) && reason == COMBO_SETTLE_TIMEOUT) {
+            continue;
+        }
+        uint8_t size = combo_key_count(combo);
+        if (size > best_size) {
+            best = i;
+            best_size = size;
+        }
+    }
+    if (best >= 0) {
+        combo_fire(best);
+    }
+
+    // Whatever is left goes on as normal presses
+    keyrecord_t dump[COMBO_KEY_BUFFER_LENGTH];
+    uint8_t count = combo_buffer_count;
+    memcpy(dump, combo_buffer, sizeof(dump));
+    combo_buffer_count = 0;
+    memset(combo_candidates, 0, sizeof(combo_candidates));
+    combo_update_state();
+    for (uint8_t k = 0; k < count; k++) {
+        tapping_process(&dump[k]);
+    }
+}
+
+// Release of a key that belongs to a fired combo
+static bool combo_release(keyrecord_t *record) {
+    for (uint8_t i = 0; i < HOST_ACTIVE_COMBOS; i++) {
+        active_combo_t *active = &active_combos[i];
+        if (!active->used) {
+            continue;
+        }
+        for (uint8_t k = 0; k < active->count; k++) {
+            keypos_t key = active->keys[k];
+            if (key.row != record->event.key.row ||
+                key.col != record->event.key.col) {
+                continue;
+            }
+
+            // The combo lets go with its first key
+            if (!active->released) {
+                active->released = true;
+                combo_t *combo = combo_get(active->index);
+                if (combo->keycode != KC_NO) {
+                    keyrecord_t release = {
+                        .event = {.key = {.col = 254, .row = 254},
+                                  .time = timer_read(),
+                                  .type = COMBO_EVENT,
+                                  .pressed = false},
+                        .keycode = combo->keycode,
+                    };
+                    tapping_process(&release);
+                }
+                process_combo_event(active->index, false);
+            }
+
+            active->keys[k] = active->keys[--active->count];
+            if (active->count == 0) {
+                active->used = false;
+                combo_t *combo = combo_get(active->index);
+                combo->active = false;
+                combo->state = 0;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+static void combo_process(keyrecord_t *record) {
+    uint16_t keycode = combo_base_keycode(record);
+
+    if (record->event.pressed) {
+        if (combo_buffer_count > 0) {
+            if (combo_try_buffer(record, keycode)) {
+                return;
+            }
+            combo_settle(COMBO_SETTLE_PRESS);
+        }
+        if (!combo_try_buffer(record, keycode)) {
+            tapping_process(record);
+        }
+        return;
+    }
+
+    if (combo_release(record)) {
+        return;
+    }
+    for (uint8_t k = 0; k < combo_buffer_count; k++) {
+        if (same_key(&combo_buffer[k], record)) {
+            combo_settle(COMBO_SETTLE_RELEASE);
+            if (combo_release(record)) {
+                return;
+            }
+            break;
+        }
+    }
+    tapping_process(record);
+}
+
+/**
+ * QMK's entry point, for userspace that feeds the engine an event of its
+ * own. Only that case is modelled: anything but a key press settles the
+ * held-back keys, like a key outside every candidate combo does.
+ */
+bool process_combo(uint16_t keycode, keyrecord_t *record) {
+    if (!IS_KEYEVENT(record->event) && combo_buffer_count > 0) {
+        combo_settle(COMBO_SETTLE_PRESS);
+    }
+    return true;
+}
+
+static void combo_task(void) {
+    if (combo_buffer_count > 0 &&
+        TIMER_DIFF_16(timer_read(), combo_timer) >= combo_wait()) {
+        combo_settle(COMBO_SETTLE_TIMEOUT);
+    }
+}
+#else
+static void combo_process(keyrecord_t *record) { tapping_process(record); }
+static void combo_task(void) {}
+#endif // COMBO_ENABLE
+
+/* ==========================================================================
+ * MAIN LOOP
+ * ==========================================================================
+ */
+static void host_task(void) {
+    combo_task();
+    tapping_task();
+
+    if (leader_active && leader_sequence_timed_out()) {
+        leader_end();
+    }
+    if (caps_word_active && now_ms - caps_word_time >= CAPS_WORD_IDLE_TIMEOUT) {
+        caps_word_off();
+    }
+#ifdef ONESHOT_TIMEOUT
+    if (oneshot_mods && now_ms - oneshot_time >= ONESHOT_TIMEOUT) {
+        clear_oneshot_mods();
+    }
+#endif
+
+    matrix_scan_user();
+    housekeeping_task_user();
+}
+
+// One scan per ms up to `until`
+static void host_advance(uint32_t until) {
+    while (now_ms < until) {
+        now_ms++;
+        host_task();
+    }
+}
+
+static void host_key(uint32_t time, uint8_t row, uint8_t col, bool pressed) {
+    if (row >= MATRIX_ROWS || col >= MATRIX_COLS) {
+        fprintf(stderr, "qmk_host: no key at row %u col %u\n", row, col);
+        return;
+    }
+
+    host_advance(time);
+    last_input_ms = now_ms;
+
+    keyrecord_t record = {
+        .event = {.key = {.col = col, .row = row},
+                  .time = (uint16_t)now_ms,
+                  .type = KEY_EVENT,
+                  .pressed = pressed},
+    };
+    if (!pre_process_record_user(record_keycode(&record, false), &record)) {
+        return;
+    }
+    combo_process(&record);
+}
+
+#ifdef RAW_ENABLE
+void raw_hid_receive(uint8_t *data, uint8_t length);
+
+static void host_raw_hid(const char *hex) {
+    uint8_t data[RAW_EPSIZE] = {0};
+    unsigned byte;
+    int used;
+    for (uint8_t i = 0; i < RAW_EPSIZE && sscanf(hex, " %x%n", &byte, &used) == 1;
+         i++) {
+        data[i] = byte;
+        hex += used;
+    }
+    raw_hid_receive(data, RAW_EPSIZE);
+}
+#endif
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "--keys") == 0) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                uint16_t keycode =
+                    keymap_key_to_keycode(0, (keypos_t){.col = col, .row = row});
+                if (keycode != KC_NO) {
+                    printf("K %u %u %04x %04x %c\n", row, col, keycode,
+                           get_tap_keycode(keycode),
+                           host_handedness((keypos_t){.col = col, .row = row}));
+                }
+            }
+        }
+        return 0;
+    }
+
+    // Fresh EEPROM, like a first boot
+    eeconfig_init_user_datablock();
+    eeconfig_init_user();
+    keyboard_post_init_user();
+
+    char line[512];
+    while (fgets(line, sizeof(line), stdin) != NULL) {
+        char op;
+        unsigned time, row, col;
+
+        if (sscanf(line, " %c", &op) != 1 || op == '#') {
+            continue;
+        }
+        switch (op) {
+        case 'p':
+        case 'r':
+            if (sscanf(line, " %c %u %u %u", &op, &time, &row, &col) == 4) {
+                host_key(time, row, col, op == 'p');
+            }
+            break;
+        case 't':
+            if (sscanf(line, " %c %u", &op, &time) == 2) {
+                host_advance(time);
+            }
+            break;
+#ifdef RAW_ENABLE
+        case 'h':
+            host_raw_hid(strchr(line, 'h') + 1);
+            break;
+#endif
+        default:
+            fprintf(stderr, "qmk_host: bad command: %s", line);
+            break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,521 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * qmk_host.h - Just enough of the QMK API to run the userspace on a PC
+ *
+ * Used as QMK_KEYBOARD_H by the host tools (tools/replay.py,
+ * tools/holdtap_bench.py, tools/tft_render.py). It declares the slice of
+ * QMK that naughtyusername.c, numword.c, keyrecords.c / combos.h, the
+ * keymap and the Halcyon display use, with QMK's keycode values. qmk_host.c
+ * implements it: a virtual clock, the layer stack, a simplified combo
+ * engine and tap-hold resolver, and a HID report log. The display build
+ * links tft_host.c instead, which only drives layers, LEDs and WPM.
+ *
+ * This is not QMK. Anything not listed here doesn't exist on the host, and
+ * the tools build with -Werror=implicit-function-declaration so a new
+ * dependency shows up as a build error instead of a silent stub.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==========================================================================
+ * BOARD / TOOLCHAIN
+ * ==========================================================================
+ * The board's matrix size comes from its config (MATRIX_ROWS) or the tool
+ * (-DMATRIX_COLS=...). Split boards put the left half in the first
+ * MATRIX_ROWS / 2 rows, which is what handedness goes by.
+ */
+#ifndef MATRIX_ROWS
+#    error "MATRIX_ROWS not set - the host tools pass it per board"
+#endif
+#ifndef MATRIX_COLS
+#    error "MATRIX_COLS not set - the host tools pass it per board"
+#endif
+
+#define PROGMEM
+#define PSTR(s) s
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define pgm_read_dword(p) (*(const uint32_t *)(p))
+#define pgm_read_ptr(p) (*(void *const *)(p))
+#define memcpy_P memcpy
+
+#ifndef MIN
+#    define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef MAX
+#    define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+#define STATIC_ASSERT _Static_assert
+
+/* ==========================================================================
+ * KEY EVENTS
+ * ==========================================================================
+ */
+typedef uint32_t layer_state_t;
+
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} keypos_t;
+
+typedef enum {
+    TICK_EVENT = 0,
+    KEY_EVENT = 1,
+    ENCODER_CW_EVENT = 2,
+    ENCODER_CCW_EVENT = 3,
+    COMBO_EVENT = 4,
+} keyevent_type_t;
+
+typedef struct {
+    keypos_t key;
+    uint16_t time;
+    keyevent_type_t type;
+    bool pressed;
+} keyevent_t;
+
+typedef struct {
+    bool interrupted : 1;
+    bool reserved2 : 1;
+    bool reserved1 : 1;
+    bool reserved0 : 1;
+    uint8_t count : 4;
+} tap_t;
+
+typedef struct {
+    keyevent_t event;
+    tap_t tap;
+    uint16_t keycode;
+} keyrecord_t;
+
+#define IS_KEYEVENT(event) ((event).type == KEY_EVENT)
+#define IS_COMBOEVENT(event) ((event).type == COMBO_EVENT)
+#define KEYEQ(keya, keyb) ((keya).row == (keyb).row && (keya).col == (keyb).col)
+#define MAKE_TICK_EVENT                                                        \
+    ((keyevent_t){.key = {.col = 255, .row = 255},                             \
+                  .time = timer_read() | 1,                                    \
+                  .type = TICK_EVENT,                                          \
+                  .pressed = false})
+
+/* ==========================================================================
+ * KEYCODES
+ * ==========================================================================
+ * Same values as QMK's keycodes.h, so a trace names the same keys.
+ */
+// clang-format off
+enum qk_keycode_defines {
+    KC_NO = 0x0000, KC_TRANSPARENT = 0x0001,
+    KC_A = 0x0004, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K,
+    KC_L, KC_M, KC_N, KC_O, KC_P, KC_Q, KC_R, KC_S, KC_T, KC_U, KC_V, KC_W,
+    KC_X, KC_Y, KC_Z,
+    KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0,
+    KC_ENTER, KC_ESCAPE, KC_BACKSPACE, KC_TAB, KC_SPACE, KC_MINUS, KC_EQUAL,
+    KC_LEFT_BRACKET, KC_RIGHT_BRACKET, KC_BACKSLASH, KC_NONUS_HASH,
+    KC_SEMICOLON, KC_QUOTE, KC_GRAVE, KC_COMMA, KC_DOT, KC_SLASH,
+    KC_CAPS_LOCK,
+    KC_F1, KC_F2, KC_F3, KC_F4, KC_F5, KC_F6, KC_F7, KC_F8, KC_F9, KC_F10,
+    KC_F11, KC_F12,
+    KC_PRINT_SCREEN, KC_SCROLL_LOCK, KC_PAUSE, KC_INSERT, KC_HOME,
+    KC_PAGE_UP, KC_DELETE, KC_END, KC_PAGE_DOWN, KC_RIGHT, KC_LEFT, KC_DOWN,
+    KC_UP, KC_NUM_LOCK,
+    KC_KP_SLASH, KC_KP_ASTERISK, KC_KP_MINUS, KC_KP_PLUS, KC_KP_ENTER,
+    KC_KP_1, KC_KP_2, KC_KP_3, KC_KP_4, KC_KP_5, KC_KP_6, KC_KP_7, KC_KP_8,
+    KC_KP_9, KC_KP_0, KC_KP_DOT,
+
+    KC_AUDIO_MUTE = 0x00A8, KC_AUDIO_VOL_UP, KC_AUDIO_VOL_DOWN,
+    KC_MEDIA_NEXT_TRACK, KC_MEDIA_PREV_TRACK, KC_MEDIA_STOP,
+    KC_MEDIA_PLAY_PAUSE,
+
+    MS_UP = 0x00CD, MS_DOWN, MS_LEFT, MS_RGHT,
+    MS_BTN1, MS_BTN2, MS_BTN3, MS_BTN4, MS_BTN5, MS_BTN6, MS_BTN7, MS_BTN8,
+    MS_WHLU, MS_WHLD, MS_WHLL, MS_WHLR, MS_ACL0, MS_ACL1, MS_ACL2,
+
+    KC_LEFT_CTRL = 0x00E0, KC_LEFT_SHIFT, KC_LEFT_ALT, KC_LEFT_GUI,
+    KC_RIGHT_CTRL, KC_RIGHT_SHIFT, KC_RIGHT_ALT, KC_RIGHT_GUI,
+
+    QK_MODS = 0x0100, QK_MODS_MAX = 0x1FFF,
+    QK_MOD_TAP = 0x2000, QK_MOD_TAP_MAX = 0x3FFF,
+    QK_LAYER_TAP = 0x4000, QK_LAYER_TAP_MAX = 0x4FFF,
+    QK_TO = 0x5200, QK_TO_MAX = 0x521F,
+    QK_MOMENTARY = 0x5220, QK_MOMENTARY_MAX = 0x523F,
+    QK_DEF_LAYER = 0x5240, QK_DEF_LAYER_MAX = 0x525F,
+    QK_TOGGLE_LAYER = 0x5260, QK_TOGGLE_LAYER_MAX = 0x527F,
+    QK_ONE_SHOT_LAYER = 0x5280, QK_ONE_SHOT_LAYER_MAX = 0x529F,
+    QK_ONE_SHOT_MOD = 0x52A0, QK_ONE_SHOT_MOD_MAX = 0x52BF,
+    QK_TAP_DANCE = 0x5700, QK_TAP_DANCE_MAX = 0x57FF,
+
+    NK_TOGG = 0x7013,
+    RM_ON = 0x7840, RM_OFF, RM_TOGG, RM_NEXT, RM_PREV, RM_HUEU, RM_HUED,
+    RM_SATU, RM_SATD, RM_VALU, RM_VALD, RM_SPDU, RM_SPDD,
+    QK_BOOT = 0x7C00, EE_CLR = 0x7C03,
+    QK_LEADER = 0x7C58,
+    CW_TOGG = 0x7C73,
+    QK_REP = 0x7C79,
+    QK_USER = 0x7E40, QK_USER_MAX = 0x7FFF,
+};
+// clang-format on
+
+#define KC_TRNS KC_TRANSPARENT
+#define _______ KC_TRANSPARENT
+#define XXXXXXX KC_NO
+#define KC_ENT KC_ENTER
+#define KC_ESC KC_ESCAPE
+#define KC_BSPC KC_BACKSPACE
+#define KC_SPC KC_SPACE
+#define KC_MINS KC_MINUS
+#define KC_EQL KC_EQUAL
+#define KC_LBRC KC_LEFT_BRACKET
+#define KC_RBRC KC_RIGHT_BRACKET
+#define KC_BSLS KC_BACKSLASH
+#define KC_NUHS KC_NONUS_HASH
+#define KC_SCLN KC_SEMICOLON
+#define KC_QUOT KC_QUOTE
+#define KC_GRV KC_GRAVE
+#define KC_COMM KC_COMMA
+#define KC_SLSH KC_SLASH
+#define KC_CAPS KC_CAPS_LOCK
+#define KC_PSCR KC_PRINT_SCREEN
+#define KC_SCRL KC_SCROLL_LOCK
+#define KC_PAUS KC_PAUSE
+#define KC_INS KC_INSERT
+#define KC_PGUP KC_PAGE_UP
+#define KC_DEL KC_DELETE
+#define KC_PGDN KC_PAGE_DOWN
+#define KC_RGHT KC_RIGHT
+#define KC_NUM KC_NUM_LOCK
+#define KC_PSLS KC_KP_SLASH
+#define KC_PAST KC_KP_ASTERISK
+#define KC_PMNS KC_KP_MINUS
+#define KC_PPLS KC_KP_PLUS
+#define KC_PENT KC_KP_ENTER
+#define KC_P1 KC_KP_1
+#define KC_P2 KC_KP_2
+#define KC_P3 KC_KP_3
+#define KC_P4 KC_KP_4
+#define KC_P5 KC_KP_5
+#define KC_P6 KC_KP_6
+#define KC_P7 KC_KP_7
+#define KC_P8 KC_KP_8
+#define KC_P9 KC_KP_9
+#define KC_P0 KC_KP_0
+#define KC_PDOT KC_KP_DOT
+#define KC_MUTE KC_AUDIO_MUTE
+#define KC_VOLU KC_AUDIO_VOL_UP
+#define KC_VOLD KC_AUDIO_VOL_DOWN
+#define KC_MNXT KC_MEDIA_NEXT_TRACK
+#define KC_MPRV KC_MEDIA_PREV_TRACK
+#define KC_MSTP KC_MEDIA_STOP
+#define KC_MPLY KC_MEDIA_PLAY_PAUSE
+#define KC_LCTL KC_LEFT_CTRL
+#define KC_LSFT KC_LEFT_SHIFT
+#define KC_LALT KC_LEFT_ALT
+#define KC_LGUI KC_LEFT_GUI
+#define KC_RCTL KC_RIGHT_CTRL
+#define KC_RSFT KC_RIGHT_SHIFT
+#define KC_RALT KC_RIGHT_ALT
+#define KC_RGUI KC_RIGHT_GUI
+
+// Modified keycodes
+#define QK_LCTL 0x0100
+#define QK_LSFT 0x0200
+#define QK_LALT 0x0400
+#define QK_LGUI 0x0800
+#define QK_RMODS_MIN 0x1000
+#define LCTL(kc) (QK_LCTL | (kc))
+#define LSFT(kc) (QK_LSFT | (kc))
+#define LALT(kc) (QK_LALT | (kc))
+#define LGUI(kc) (QK_LGUI | (kc))
+#define C(kc) LCTL(kc)
+#define S(kc) LSFT(kc)
+#define A(kc) LALT(kc)
+#define G(kc) LGUI(kc)
+#define QK_MODS_GET_MODS(kc) (((kc) >> 8) & 0x1F)
+#define QK_MODS_GET_BASIC_KEYCODE(kc) ((kc) & 0xFF)
+
+#define KC_TILD S(KC_GRV)
+#define KC_EXLM S(KC_1)
+#define KC_AT S(KC_2)
+#define KC_HASH S(KC_3)
+#define KC_DLR S(KC_4)
+#define KC_PERC S(KC_5)
+#define KC_CIRC S(KC_6)
+#define KC_AMPR S(KC_7)
+#define KC_ASTR S(KC_8)
+#define KC_LPRN S(KC_9)
+#define KC_RPRN S(KC_0)
+#define KC_UNDS S(KC_MINS)
+#define KC_PLUS S(KC_EQL)
+#define KC_LCBR S(KC_LBRC)
+#define KC_RCBR S(KC_RBRC)
+#define KC_PIPE S(KC_BSLS)
+#define KC_COLN S(KC_SCLN)
+#define KC_COLON KC_COLN
+#define KC_DQUO S(KC_QUOT)
+#define KC_DQT KC_DQUO
+#define KC_LT S(KC_COMM)
+#define KC_GT S(KC_DOT)
+#define KC_QUES S(KC_SLSH)
+
+// 5-bit mod field: bit 4 = right hand
+#define MOD_LCTL 0x01
+#define MOD_LSFT 0x02
+#define MOD_LALT 0x04
+#define MOD_LGUI 0x08
+#define MOD_RCTL 0x11
+#define MOD_RSFT 0x12
+#define MOD_RALT 0x14
+#define MOD_RGUI 0x18
+
+// 8-bit HID mod bits
+#define MOD_BIT(kc) (1 << ((kc) & 0x7))
+#define MOD_BIT_LCTRL MOD_BIT(KC_LCTL)
+#define MOD_BIT_LSHIFT MOD_BIT(KC_LSFT)
+#define MOD_BIT_LALT MOD_BIT(KC_LALT)
+#define MOD_BIT_LGUI MOD_BIT(KC_LGUI)
+#define MOD_MASK_CTRL (MOD_BIT(KC_LCTL) | MOD_BIT(KC_RCTL))
+#define MOD_MASK_SHIFT (MOD_BIT(KC_LSFT) | MOD_BIT(KC_RSFT))
+#define MOD_MASK_ALT (MOD_BIT(KC_LALT) | MOD_BIT(KC_RALT))
+#define MOD_MASK_GUI (MOD_BIT(KC_LGUI) | MOD_BIT(KC_RGUI))
+#define MOD_MASK_CS (MOD_MASK_CTRL | MOD_MASK_SHIFT)
+#define MOD_MASK_CA (MOD_MASK_CTRL | MOD_MASK_ALT)
+#define MOD_MASK_CG (MOD_MASK_CTRL | MOD_MASK_GUI)
+#define MOD_MASK_SA (MOD_MASK_SHIFT | MOD_MASK_ALT)
+
+#define MT(mod, kc) (QK_MOD_TAP | (((mod) & 0x1F) << 8) | ((kc) & 0xFF))
+#define LCTL_T(kc) MT(MOD_LCTL, kc)
+#define LSFT_T(kc) MT(MOD_LSFT, kc)
+#define LALT_T(kc) MT(MOD_LALT, kc)
+#define LGUI_T(kc) MT(MOD_LGUI, kc)
+#define RCTL_T(kc) MT(MOD_RCTL, kc)
+#define RSFT_T(kc) MT(MOD_RSFT, kc)
+#define RALT_T(kc) MT(MOD_RALT, kc)
+#define RGUI_T(kc) MT(MOD_RGUI, kc)
+#define QK_MOD_TAP_GET_MODS(kc) (((kc) >> 8) & 0x1F)
+#define QK_MOD_TAP_GET_TAP_KEYCODE(kc) ((kc) & 0xFF)
+
+#define LT(layer, kc) (QK_LAYER_TAP | (((layer) & 0xF) << 8) | ((kc) & 0xFF))
+#define QK_LAYER_TAP_GET_LAYER(kc) (((kc) >> 8) & 0xF)
+#define QK_LAYER_TAP_GET_TAP_KEYCODE(kc) ((kc) & 0xFF)
+
+#define TO(layer) (QK_TO | ((layer) & 0x1F))
+#define MO(layer) (QK_MOMENTARY | ((layer) & 0x1F))
+#define DF(layer) (QK_DEF_LAYER | ((layer) & 0x1F))
+#define TG(layer) (QK_TOGGLE_LAYER | ((layer) & 0x1F))
+#define OSL(layer) (QK_ONE_SHOT_LAYER | ((layer) & 0x1F))
+#define OSM(mod) (QK_ONE_SHOT_MOD | ((mod) & 0x1F))
+
+#define IS_QK_BASIC(kc) ((kc) <= 0x00FF)
+#define IS_QK_MODS(kc) ((kc) >= QK_MODS && (kc) <= QK_MODS_MAX)
+#define IS_QK_MOD_TAP(kc) ((kc) >= QK_MOD_TAP && (kc) <= QK_MOD_TAP_MAX)
+#define IS_QK_LAYER_TAP(kc) ((kc) >= QK_LAYER_TAP && (kc) <= QK_LAYER_TAP_MAX)
+#define IS_MODIFIER_KEYCODE(kc) ((kc) >= KC_LEFT_CTRL && (kc) <= KC_RIGHT_GUI)
+
+/* ==========================================================================
+ * SEND_STRING
+ * ==========================================================================
+ */
+#define SS_TAP_CODE 1
+#define SS_DOWN_CODE 2
+#define SS_UP_CODE 3
+#define SS_STRINGIZE_(s) #s
+#define SS_STRINGIZE(s) SS_STRINGIZE_(s)
+#define SS_ADD_SLASH_X(hex) SS_STRINGIZE(\x##hex)
+#define SS_TAP(kc) "\1" SS_ADD_SLASH_X(kc)
+#define SS_DOWN(kc) "\2" SS_ADD_SLASH_X(kc)
+#define SS_UP(kc) "\3" SS_ADD_SLASH_X(kc)
+#define SEND_STRING(s) send_string_P(PSTR(s))
+
+// X_ names are the keycode as hex digits, pasted after \x by SS_TAP()
+#define X_ENTER 28
+#define X_ESCAPE 29
+#define X_BACKSPACE 2a
+#define X_TAB 2b
+#define X_HOME 4a
+#define X_END 4d
+#define X_RIGHT 4f
+#define X_LEFT 50
+#define X_DOWN 51
+#define X_UP 52
+#define X_ENT X_ENTER
+#define X_ESC X_ESCAPE
+#define X_BSPC X_BACKSPACE
+#define X_RGHT X_RIGHT
+
+void send_string(const char *string);
+void send_string_P(const char *string);
+void send_char(char ascii_code);
+const char *get_u16_str(uint16_t curr_num, char curr_pad);
+
+/* ==========================================================================
+ * ACTIONS
+ * ==========================================================================
+ */
+void register_code(uint8_t code);
+void unregister_code(uint8_t code);
+void tap_code(uint8_t code);
+void register_code16(uint16_t code);
+void unregister_code16(uint16_t code);
+void tap_code16(uint16_t code);
+
+uint8_t get_mods(void);
+void add_mods(uint8_t mods);
+void del_mods(uint8_t mods);
+void set_mods(uint8_t mods);
+void clear_mods(void);
+void register_mods(uint8_t mods);
+void unregister_mods(uint8_t mods);
+uint8_t get_oneshot_mods(void);
+void add_oneshot_mods(uint8_t mods);
+void clear_oneshot_mods(void);
+void send_keyboard_report(void);
+
+uint16_t get_tap_keycode(uint16_t keycode);
+bool get_chordal_hold_default(keyrecord_t *tap_hold_record,
+                              keyrecord_t *other_record);
+
+/* ==========================================================================
+ * LAYERS
+ * ==========================================================================
+ */
+extern layer_state_t layer_state;
+extern layer_state_t default_layer_state;
+bool layer_state_is(uint8_t layer);
+bool layer_state_cmp(layer_state_t state, uint8_t layer);
+void layer_on(uint8_t layer);
+void layer_off(uint8_t layer);
+void layer_move(uint8_t layer);
+void layer_invert(uint8_t layer);
+void layer_clear(void);
+uint8_t get_highest_layer(layer_state_t state);
+layer_state_t update_tri_layer_state(layer_state_t state, uint8_t layer1,
+                                     uint8_t layer2, uint8_t layer3);
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
+
+/* ==========================================================================
+ * TIMER
+ * ==========================================================================
+ * The virtual clock, in ms. It only moves when the trace says so.
+ */
+uint16_t timer_read(void);
+uint32_t timer_read32(void);
+uint16_t timer_elapsed(uint16_t last);
+uint32_t timer_elapsed32(uint32_t last);
+#define TIMER_DIFF(a, b, max) ((max == UINT8_MAX) ? ((uint8_t)((a) - (b))) : ((max == UINT16_MAX) ? ((uint16_t)((a) - (b))) : ((max == UINT32_MAX) ? ((uint32_t)((a) - (b))) : ((a) >= (b) ? (a) - (b) : (max) + 1 - (b) + (a)))))
+#define TIMER_DIFF_8(a, b) TIMER_DIFF(a, b, UINT8_MAX)
+#define TIMER_DIFF_16(a, b) TIMER_DIFF(a, b, UINT16_MAX)
+#define TIMER_DIFF_32(a, b) TIMER_DIFF(a, b, UINT32_MAX)
+void wait_ms(uint32_t ms);
+uint32_t last_input_activity_elapsed(void);
+
+/* ==========================================================================
+ * FEATURES
+ * ==========================================================================
+ * Caps Word, Repeat Key, Leader and key overrides are small models of the
+ * QMK features, enough for the userspace to drive them.
+ */
+typedef union {
+    uint8_t raw;
+    struct {
+        bool num_lock : 1;
+        bool caps_lock : 1;
+        bool scroll_lock : 1;
+        bool compose : 1;
+        bool kana : 1;
+        uint8_t reserved : 3;
+    };
+} led_t;
+led_t host_keyboard_led_state(void);
+bool is_keyboard_master(void);
+bool is_keyboard_left(void);
+uint8_t get_current_wpm(void);
+
+bool is_caps_word_on(void);
+void caps_word_on(void);
+void caps_word_off(void);
+void caps_word_toggle(void);
+
+typedef struct {
+    uint8_t trigger_mods;
+    uint16_t trigger;
+    uint16_t replacement;
+} key_override_t;
+#define ko_make_basic(mods, trigger_key, replacement_key)                      \
+    ((const key_override_t){.trigger_mods = (mods),                            \
+                            .trigger = (trigger_key),                          \
+                            .replacement = (replacement_key)})
+
+typedef struct {
+    int unused;
+} tap_dance_action_t;
+
+// Combos - the engine in qmk_host.c follows QMK's combo.c in spirit
+typedef struct combo_t {
+    const uint16_t *keys;
+    uint16_t keycode;
+    bool disabled; // all keys down, but too slow or on the wrong layer
+    bool active;   // fired, keys still held
+    uint8_t state; // bit per key index that is down
+} combo_t;
+#define COMBO_END 0
+#define COMBO(ck, ca) {.keys = &(ck)[0], .keycode = (ca)}
+#define COMBO_ACTION(ck) {.keys = &(ck)[0]}
+#ifndef COMBO_KEY_BUFFER_LENGTH
+#    define COMBO_KEY_BUFFER_LENGTH 8
+#endif
+uint16_t combo_count(void);
+combo_t *combo_get(uint16_t combo_idx);
+bool process_combo(uint16_t keycode, keyrecord_t *record);
+
+/* ==========================================================================
+ * RAW HID / EEPROM
+ * ==========================================================================
+ * raw_hid_send() answers go to the tool's stdout; the user datablock is
+ * plain RAM that starts out erased every run.
+ */
+#define RAW_EPSIZE 32
+void raw_hid_send(uint8_t *data, uint8_t length);
+void eeconfig_read_user_datablock(void *data, uint32_t offset, uint32_t length);
+void eeconfig_update_user_datablock(const void *data, uint32_t offset,
+                                    uint32_t length);
+bool eeconfig_is_user_datablock_valid(void);
+void eeconfig_init_user_datablock(void);
+
+/* ==========================================================================
+ * USER CALLBACKS
+ * ==========================================================================
+ * Everything the userspace can implement. qmk_host.c has weak defaults.
+ */
+bool pre_process_record_user(uint16_t keycode, keyrecord_t *record);
+bool process_record_user(uint16_t keycode, keyrecord_t *record);
+void post_process_record_user(uint16_t keycode, keyrecord_t *record);
+layer_state_t layer_state_set_user(layer_state_t state);
+void matrix_scan_user(void);
+void housekeeping_task_user(void);
+void keyboard_post_init_user(void);
+void eeconfig_init_user(void);
+
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record);
+uint16_t get_quick_tap_term(uint16_t keycode, keyrecord_t *record);
+bool get_chordal_hold(uint16_t tap_hold_keycode, keyrecord_t *tap_hold_record,
+                      uint16_t other_keycode, keyrecord_t *other_record);
+bool is_flow_tap_key(uint16_t keycode);
+uint16_t get_flow_tap_term(uint16_t keycode, keyrecord_t *record,
+                           uint16_t prev_keycode);
+bool get_speculative_hold(uint16_t keycode, keyrecord_t *record);
+
+void process_combo_event(uint16_t combo_index, bool pressed);
+uint16_t get_combo_term(uint16_t combo_index, combo_t *combo);
+bool get_combo_must_hold(uint16_t combo_index, combo_t *combo);
+bool get_combo_must_tap(uint16_t combo_index, combo_t *combo);
+bool combo_should_trigger(uint16_t combo_index, combo_t *combo,
+                          uint16_t keycode, keyrecord_t *record);
+
+void leader_start_user(void);
+void leader_end_user(void);
@@ -0,0 +1,85 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * qp.h - Quantum Painter for the host TFT renderer (tools/tft_render.py)
+ *
+ * The calls hlc_tft_display.c makes, implemented in qp_host.c. Surfaces
+ * are real RGB565 buffers, QFF fonts and QGF images are decoded (mono /
+ * grayscale, raw or RLE) the way QMK does. The ST7789 is a 135x240 RGB565
+ * "panel" that keeps whatever arrives over SPI after a qp_viewport(), so
+ * what the tool saves is what the display pipeline actually sent.
+ */
+
+#pragma once
+
+#include "qmk_host.h"
+
+typedef const void *painter_device_t;
+
+typedef enum {
+    QP_ROTATION_0,
+    QP_ROTATION_90,
+    QP_ROTATION_180,
+    QP_ROTATION_270,
+} painter_rotation_t;
+
+typedef struct {
+    uint8_t line_height;
+} painter_font_desc_t;
+typedef const painter_font_desc_t *painter_font_handle_t;
+
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint16_t frame_count;
+} painter_image_desc_t;
+typedef const painter_image_desc_t *painter_image_handle_t;
+
+bool qp_init(painter_device_t device, painter_rotation_t rotation);
+bool qp_power(painter_device_t device, bool power_on);
+bool qp_clear(painter_device_t device);
+bool qp_flush(painter_device_t device);
+void qp_set_viewport_offsets(painter_device_t device, uint16_t offset_x,
+                             uint16_t offset_y);
+bool qp_viewport(painter_device_t device, uint16_t left, uint16_t top,
+                 uint16_t right, uint16_t bottom);
+
+bool qp_setpixel(painter_device_t device, uint16_t x, uint16_t y,
+                 uint8_t hue, uint8_t sat, uint8_t val);
+bool qp_rect(painter_device_t device, uint16_t left, uint16_t top,
+             uint16_t right, uint16_t bottom, uint8_t hue, uint8_t sat,
+             uint8_t val, bool filled);
+
+painter_font_handle_t qp_load_font_mem(const uint8_t *buffer);
+bool qp_close_font(painter_font_handle_t font);
+int16_t qp_textwidth(painter_font_handle_t font, const char *str);
+int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y,
+                            painter_font_handle_t font, const char *str,
+                            uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg,
+                            uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
+
+painter_image_handle_t qp_load_image_mem(const void *buffer);
+bool qp_close_image(painter_image_handle_t image);
+bool qp_drawimage_recolor(painter_device_t device, uint16_t x, uint16_t y,
+                          painter_image_handle_t image, uint8_t hue_fg,
+                          uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg,
+                          uint8_t sat_bg, uint8_t val_bg);
+
+painter_device_t qp_st7789_make_spi_device(uint16_t panel_width,
+                                           uint16_t panel_height,
+                                           uint32_t chip_select_pin,
+                                           uint32_t dc_pin,
+                                           uint32_t reset_pin,
+                                           uint16_t spi_divisor, int spi_mode);
+
+// QMK's backlight.h, the display turns the backlight on next to QP
+void backlight_enable(void);
+
+/* ==========================================================================
+ * HOST ONLY
+ * ==========================================================================
+ * What the tool reads back: the panel's pixels as sent (RGB565, big endian
+ * like the wire) and how many bytes went over SPI so far.
+ */
+bool qp_host_save_panel(painter_device_t device, const char *path);
+uint32_t qp_host_spi_bytes(void);
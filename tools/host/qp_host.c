@@ -0,0 +1,507 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * qp_host.c - Just enough Quantum Painter to run hlc_tft_display.c on a PC
+ *
+ * Two kinds of device, both RGB565 in QMK's native (byte swapped) order:
+ *   - surfaces, drawn into the caller's buffer like qp_make_rgb565_surface
+ *   - the ST7789 "panel", which also takes pixels over SPI: qp_viewport()
+ *     sets the window, spiStartSend() fills it left to right, top to bottom
+ *
+ * Fonts (QFF) and images (QGF) are parsed from the same arrays the
+ * firmware links. Only the grayscale formats are decoded (1/2/4/8 bpp, raw
+ * or RLE), which is all the display's assets use; anything else is
+ * reported and not drawn. Recoloring interpolates fg / bg in HSV and goes
+ * through hsv_to_rgb_nocie() like QMK, so the pixels should match the
+ * firmware's bit for bit.
+ */
+
+#include <stdio.h>
+
+#include "qp.h"
+#include "qp_surface.h"
+#include "spi_master.h"
+
+/* ==========================================================================
+ * DEVICES
+ * ==========================================================================
+ */
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint16_t *pixels; // Native RGB565
+    bool panel;
+
+    // Window of the last qp_viewport(), and the next pixel in it
+    uint16_t left, top, right, bottom;
+    uint32_t next;
+} host_device_t;
+
+static host_device_t *panel_device;
+static uint32_t spi_bytes;
+
+static host_device_t *make_device(uint16_t width, uint16_t height,
+                                  uint16_t *pixels, bool panel) {
+    host_device_t *dev = calloc(1, sizeof(*dev));
+    dev->width = width;
+    dev->height = height;
+    dev->pixels = pixels ? pixels : calloc((size_t)width * height, 2);
+    dev->panel = panel;
+    dev->right = width - 1;
+    dev->bottom = height - 1;
+    return dev;
+}
+
+painter_device_t qp_make_rgb565_surface(uint16_t panel_width,
+                                        uint16_t panel_height, void *buffer) {
+    return make_device(panel_width, panel_height, buffer, false);
+}
+
+painter_device_t qp_st7789_make_spi_device(uint16_t panel_width,
+                                           uint16_t panel_height,
+                                           uint32_t chip_select_pin,
+                                           uint32_t dc_pin,
+                                           uint32_t reset_pin,
+                                           uint16_t spi_divisor, int spi_mode) {
+    panel_device = make_device(panel_width, panel_height, NULL, true);
+    return panel_device;
+}
+
+bool qp_init(painter_device_t device, painter_rotation_t rotation) {
+    if (rotation != QP_ROTATION_0) {
+        fprintf(stderr, "qp_host: only QP_ROTATION_0 is supported\n");
+        return false;
+    }
+    return true;
+}
+
+bool qp_power(painter_device_t device, bool power_on) { return true; }
+
+bool qp_flush(painter_device_t device) { return true; }
+
+// Offsets only move the picture on the glass, the panel buffer is the
+// logical screen
+void qp_set_viewport_offsets(painter_device_t device, uint16_t offset_x,
+                             uint16_t offset_y) {}
+
+bool qp_viewport(painter_device_t device, uint16_t left, uint16_t top,
+                 uint16_t right, uint16_t bottom) {
+    host_device_t *dev = (host_device_t *)device;
+    if (left > right || top > bottom || right >= dev->width ||
+        bottom >= dev->height) {
+        return false;
+    }
+    dev->left = left;
+    dev->top = top;
+    dev->right = right;
+    dev->bottom = bottom;
+    dev->next = 0;
+    return true;
+}
+
+// Write the next pixel of the window, dropping anything past its end
+static void window_push(host_device_t *dev, uint16_t native) {
+    uint16_t w = dev->right - dev->left + 1;
+    uint32_t y = dev->top + dev->next / w;
+    if (y <= dev->bottom) {
+        dev->pixels[y * dev->width + dev->left + dev->next % w] = native;
+        dev->next++;
+    }
+}
+
+/* ==========================================================================
+ * COLOR
+ * ==========================================================================
+ */
+typedef struct {
+    uint8_t h, s, v;
+} host_hsv_t;
+
+// QMK's hsv_to_rgb_nocie() to RGB565, byte swapped like the surface and
+// ST7789 drivers store it
+static uint16_t hsv_to_native(host_hsv_t hsv) {
+    uint8_t r, g, b;
+
+    if (hsv.s == 0) {
+        r = g = b = hsv.v;
+    } else {
+        uint16_t h = hsv.h, s = hsv.s, v = hsv.v;
+        uint8_t region = h * 6 / 255;
+        uint8_t remainder = (h * 2 - region * 85) * 3;
+        uint8_t p = (v * (255 - s)) >> 8;
+        uint8_t q = (v * (255 - ((s * remainder) >> 8))) >> 8;
+        uint8_t t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+        switch (region) {
+            case 6:
+            case 0: r = v, g = t, b = p; break;
+            case 1: r = q, g = v, b = p; break;
+            case 2: r = p, g = v, b = t; break;
+            case 3: r = p, g = q, b = v; break;
+            case 4: r = t, g = p, b = v; break;
+            default: r = v, g = p, b = q; break;
+        }
+    }
+
+    uint16_t rgb565 = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    return (uint16_t)((rgb565 >> 8) | (rgb565 << 8));
+}
+
+#define QP_LERP(a, b, cur, max)                                              \
+    ((int32_t)(a) + ((int32_t)(b) - (int32_t)(a)) * (int32_t)(cur) /         \
+                        ((int32_t)(max) - 1))
+
+// qp_internal_interpolate_palette(): bg at index 0, fg at the top
+static void interpolate_palette(uint16_t *palette, uint16_t steps,
+                                host_hsv_t fg, host_hsv_t bg) {
+    int16_t hue_fg = fg.h;
+    int16_t hue_bg = bg.h;
+
+    // Shortest way round the hue circle
+    if (hue_fg - hue_bg >= 128) {
+        hue_bg += 256;
+    } else if (hue_fg - hue_bg <= -128) {
+        hue_bg -= 256;
+    }
+
+    for (uint16_t i = 0; i < steps; i++) {
+        host_hsv_t c = {
+            .h = (uint8_t)QP_LERP(hue_bg, hue_fg, i, steps),
+            .s = (uint8_t)QP_LERP(bg.s, fg.s, i, steps),
+            .v = (uint8_t)QP_LERP(bg.v, fg.v, i, steps),
+        };
+        palette[i] = hsv_to_native(c);
+    }
+}
+
+/* ==========================================================================
+ * PRIMITIVES
+ * ==========================================================================
+ */
+bool qp_setpixel(painter_device_t device, uint16_t x, uint16_t y,
+                 uint8_t hue, uint8_t sat, uint8_t val) {
+    host_device_t *dev = (host_device_t *)device;
+    if (x >= dev->width || y >= dev->height) {
+        return false;
+    }
+    dev->pixels[(uint32_t)y * dev->width + x] =
+        hsv_to_native((host_hsv_t){hue, sat, val});
+    return true;
+}
+
+bool qp_rect(painter_device_t device, uint16_t left, uint16_t top,
+             uint16_t right, uint16_t bottom, uint8_t hue, uint8_t sat,
+             uint8_t val, bool filled) {
+    host_device_t *dev = (host_device_t *)device;
+    if (right >= dev->width) right = dev->width - 1;
+    if (bottom >= dev->height) bottom = dev->height - 1;
+
+    uint16_t native = hsv_to_native((host_hsv_t){hue, sat, val});
+    for (uint16_t y = top; y <= bottom; y++) {
+        for (uint16_t x = left; x <= right; x++) {
+            if (filled || y == top || y == bottom || x == left || x == right) {
+                dev->pixels[(uint32_t)y * dev->width + x] = native;
+            }
+        }
+    }
+    return true;
+}
+
+bool qp_clear(painter_device_t device) {
+    host_device_t *dev = (host_device_t *)device;
+    memset(dev->pixels, 0, (size_t)dev->width * dev->height * 2);
+    return true;
+}
+
+/* ==========================================================================
+ * QFF / QGF
+ * ==========================================================================
+ * Both are a run of blocks: type, ~type, 24-bit length, payload.
+ */
+enum {
+    BLOCK_DESCRIPTOR = 0x00,
+    QGF_BLOCK_FRAME_OFFSETS = 0x01,
+    QGF_BLOCK_FRAME = 0x02,
+    QGF_BLOCK_DATA = 0x05,
+    QFF_BLOCK_ASCII_GLYPHS = 0x01,
+    QFF_BLOCK_DATA = 0x04,
+};
+
+#define QP_COMPRESSION_RLE 1
+
+static uint32_t read_u24(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | ((uint32_t)p[2] << 16);
+}
+
+// Payload of the first block of `type`, NULL if the file has none
+static const uint8_t *find_block(const uint8_t *file, uint32_t file_size,
+                                 uint8_t type, uint32_t *length) {
+    uint32_t at = 0;
+    while (at + 5 <= file_size) {
+        uint32_t len = read_u24(&file[at + 2]);
+        if (file[at] == type && (uint8_t)~file[at + 1] == type) {
+            *length = len;
+            return &file[at + 5];
+        }
+        at += 5 + len;
+    }
+    return NULL;
+}
+
+// Byte source with QP's RLE: a marker >= 128 is followed by (marker - 127)
+// literal bytes, anything lower repeats the next byte that many times
+typedef struct {
+    const uint8_t *p, *end;
+    bool rle;
+    bool literal;
+    uint8_t left;
+    uint8_t repeat;
+} byte_reader_t;
+
+static int next_byte(byte_reader_t *r) {
+    if (!r->rle) {
+        return r->p < r->end ? *r->p++ : -1;
+    }
+    if (!r->left) {
+        if (r->p + 1 >= r->end) return -1;
+        uint8_t marker = *r->p++;
+        r->literal = marker >= 128;
+        r->left = r->literal ? marker - 127 : marker;
+        if (!r->literal) r->repeat = *r->p++;
+    }
+    r->left--;
+    return r->literal ? (r->p < r->end ? *r->p++ : -1) : r->repeat;
+}
+
+// Decode `count` grayscale pixels (LSB first in each byte) into the
+// device's window through the palette
+static bool draw_pixels(host_device_t *dev, byte_reader_t *r, uint8_t bpp,
+                        uint32_t count, const uint16_t *palette) {
+    uint8_t mask = (1 << bpp) - 1;
+    int byte = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t shift = (i * bpp) & 7;
+        if (!shift && (byte = next_byte(r)) < 0) {
+            return false;
+        }
+        window_push(dev, palette[(byte >> shift) & mask]);
+    }
+    return true;
+}
+
+// Formats 0-3 are QP's GRAYSCALE_1/2/4/8
+static uint8_t grayscale_bpp(uint8_t format) {
+    return format <= 3 ? 1 << format : 0;
+}
+
+/* ==========================================================================
+ * FONTS
+ * ==========================================================================
+ */
+typedef struct {
+    painter_font_desc_t base; // First, so the handle is the descriptor
+    uint8_t bpp;
+    bool rle;
+    const uint8_t *glyphs; // 95 uint24: width:6, offset:18
+    const uint8_t *data;
+    uint32_t data_length;
+} host_font_t;
+
+painter_font_handle_t qp_load_font_mem(const uint8_t *buffer) {
+    const uint8_t *desc = buffer + 5;
+    if (memcmp(desc, "QFF", 3)) return NULL;
+
+    uint32_t total = desc[4] | (desc[5] << 8) | (desc[6] << 16) |
+                     ((uint32_t)desc[7] << 24);
+    uint8_t format = desc[16];
+    if (!desc[13] || !grayscale_bpp(format)) {
+        fprintf(stderr, "qp_host: font format %u not supported\n", format);
+        return NULL;
+    }
+
+    host_font_t *font = calloc(1, sizeof(*font));
+    uint32_t length;
+    font->base.line_height = desc[12];
+    font->bpp = grayscale_bpp(format);
+    font->rle = desc[18] == QP_COMPRESSION_RLE;
+    font->glyphs = find_block(buffer, total, QFF_BLOCK_ASCII_GLYPHS, &length);
+    font->data = find_block(buffer, total, QFF_BLOCK_DATA, &font->data_length);
+    if (!font->glyphs || !font->data) {
+        free(font);
+        return NULL;
+    }
+    return &font->base;
+}
+
+bool qp_close_font(painter_font_handle_t font) {
+    free((void *)font);
+    return true;
+}
+
+static bool glyph_of(const host_font_t *font, char c, uint8_t *width,
+                     uint32_t *offset) {
+    if (c < 0x20 || c > 0x7E) return false;
+    uint32_t entry = read_u24(&font->glyphs[(c - 0x20) * 3]);
+    *width = entry & 0x3F;
+    *offset = entry >> 6;
+    return true;
+}
+
+int16_t qp_textwidth(painter_font_handle_t font, const char *str) {
+    const host_font_t *f = (const host_font_t *)font;
+    int16_t width = 0;
+    uint8_t w;
+    uint32_t offset;
+    for (; *str; str++) {
+        if (glyph_of(f, *str, &w, &offset)) width += w;
+    }
+    return width;
+}
+
+int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y,
+                            painter_font_handle_t font, const char *str,
+                            uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg,
+                            uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
+    host_device_t *dev = (host_device_t *)device;
+    const host_font_t *f = (const host_font_t *)font;
+    uint16_t palette[256];
+    interpolate_palette(palette, 1 << f->bpp,
+                        (host_hsv_t){hue_fg, sat_fg, val_fg},
+                        (host_hsv_t){hue_bg, sat_bg, val_bg});
+
+    uint16_t start = x;
+    uint8_t w;
+    uint32_t offset;
+    for (; *str; str++) {
+        if (!glyph_of(f, *str, &w, &offset)) continue;
+        if (!qp_viewport(device, x, y, x + w - 1,
+                         y + f->base.line_height - 1)) {
+            break;
+        }
+
+        // Every glyph starts a fresh RLE stream at its own offset
+        byte_reader_t r = {.p = f->data + offset,
+                           .end = f->data + f->data_length,
+                           .rle = f->rle};
+        draw_pixels(dev, &r, f->bpp, (uint32_t)w * f->base.line_height,
+                    palette);
+        x += w;
+    }
+    return x - start;
+}
+
+/* ==========================================================================
+ * IMAGES
+ * ==========================================================================
+ * Only the first frame - the display has no animations.
+ */
+typedef struct {
+    painter_image_desc_t base;
+    uint8_t bpp;
+    bool rle;
+    const uint8_t *data;
+    uint32_t data_length;
+} host_image_t;
+
+painter_image_handle_t qp_load_image_mem(const void *buffer) {
+    const uint8_t *file = buffer;
+    const uint8_t *desc = file + 5;
+    if (memcmp(desc, "QGF", 3)) return NULL;
+
+    uint32_t total = desc[4] | (desc[5] << 8) | (desc[6] << 16) |
+                     ((uint32_t)desc[7] << 24);
+    uint32_t length;
+    const uint8_t *frame = find_block(file, total, QGF_BLOCK_FRAME, &length);
+    if (!frame || !grayscale_bpp(frame[0])) {
+        fprintf(stderr, "qp_host: image format %u not supported\n",
+                frame ? frame[0] : 0xFF);
+        return NULL;
+    }
+
+    host_image_t *image = calloc(1, sizeof(*image));
+    image->base.width = desc[12] | (desc[13] << 8);
+    image->base.height = desc[14] | (desc[15] << 8);
+    image->base.frame_count = desc[16] | (desc[17] << 8);
+    image->bpp = grayscale_bpp(frame[0]);
+    image->rle = frame[2] == QP_COMPRESSION_RLE;
+    image->data = find_block(file, total, QGF_BLOCK_DATA, &image->data_length);
+    if (!image->data) {
+        free(image);
+        return NULL;
+    }
+    return &image->base;
+}
+
+bool qp_close_image(painter_image_handle_t image) {
+    free((void *)image);
+    return true;
+}
+
+bool qp_drawimage_recolor(painter_device_t device, uint16_t x, uint16_t y,
+                          painter_image_handle_t image, uint8_t hue_fg,
+                          uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg,
+                          uint8_t sat_bg, uint8_t val_bg) {
+    host_device_t *dev = (host_device_t *)device;
+    const host_image_t *img = (const host_image_t *)image;
+    if (!qp_viewport(device, x, y, x + img->base.width - 1,
+                     y + img->base.height - 1)) {
+        return false;
+    }
+
+    uint16_t palette[256];
+    interpolate_palette(palette, 1 << img->bpp,
+                        (host_hsv_t){hue_fg, sat_fg, val_fg},
+                        (host_hsv_t){hue_bg, sat_bg, val_bg});
+    byte_reader_t r = {.p = img->data, .end = img->data + img->data_length,
+                       .rle = img->rle};
+    return draw_pixels(dev, &r, img->bpp,
+                       (uint32_t)img->base.width * img->base.height, palette);
+}
+
+/* ==========================================================================
+ * SPI
+ * ==========================================================================
+ * Data goes to the panel's window straight away (the display only ever
+ * sends pixel data), but the driver reads SPI_ACTIVE until the tool's next
+ * tick, like a DMA transfer still on the wire.
+ */
+SPIDriver SPID0 = {.state = SPI_READY};
+
+bool spi_start(uint32_t slave_pin, bool lsb_first, uint8_t mode,
+               uint16_t divisor) {
+    return true;
+}
+
+void spi_stop(void) {}
+
+void gpio_write_pin_high(uint32_t pin) {}
+
+void spiStartSend(SPIDriver *spip, size_t n, const void *txbuf) {
+    const uint8_t *bytes = txbuf;
+    spip->state = SPI_ACTIVE;
+    spi_bytes += n;
+    if (!panel_device) return;
+
+    for (size_t i = 0; i + 1 < n; i += 2) {
+        uint16_t native;
+        memcpy(&native, &bytes[i], 2);
+        window_push(panel_device, native);
+    }
+}
+
+/* ==========================================================================
+ * HOST ONLY
+ * ==========================================================================
+ */
+uint32_t qp_host_spi_bytes(void) { return spi_bytes; }
+
+bool qp_host_save_panel(painter_device_t device, const char *path) {
+    const host_device_t *dev = (const host_device_t *)device;
+    FILE *out = fopen(path, "wb");
+    if (!out) return false;
+
+    // Native order is already the wire's: high byte first
+    size_t count = (size_t)dev->width * dev->height;
+    bool ok = fwrite(dev->pixels, 2, count, out) == count;
+    return fclose(out) == 0 && ok;
+}
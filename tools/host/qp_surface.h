@@ -0,0 +1,15 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * qp_surface.h - Quantum Painter surfaces for the host TFT renderer
+ */
+
+#pragma once
+
+#include "qp.h"
+
+#define SURFACE_REQUIRED_BUFFER_BYTE_SIZE(w, h, bpp)                         \
+    ((((w) * (h) * (bpp)) + 7) / 8)
+
+painter_device_t qp_make_rgb565_surface(uint16_t panel_width,
+                                        uint16_t panel_height, void *buffer);
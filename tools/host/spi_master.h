@@ -0,0 +1,37 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * spi_master.h - SPI and RP2040 pins for the host TFT renderer
+ *
+ * spiStartSend() hands the bytes to the panel in qp_host.c at once and
+ * leaves the driver SPI_ACTIVE until tft_host.c's next tick.
+ */
+
+#pragma once
+
+#include "qmk_host.h"
+
+#define GP13 13
+#define GP16 16
+#define GP26 26
+#define GP27 27
+
+typedef enum {
+    SPI_UNINIT,
+    SPI_STOP,
+    SPI_READY,
+    SPI_ACTIVE,
+} spistate_t;
+
+typedef struct {
+    volatile spistate_t state;
+} SPIDriver;
+
+extern SPIDriver SPID0;
+#define SPI_DRIVER SPID0
+
+bool spi_start(uint32_t slave_pin, bool lsb_first, uint8_t mode,
+               uint16_t divisor);
+void spi_stop(void);
+void spiStartSend(SPIDriver *spip, size_t n, const void *txbuf);
+void gpio_write_pin_high(uint32_t pin);
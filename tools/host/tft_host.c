@@ -0,0 +1,214 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * tft_host.c - Runs the Halcyon TFT display on a PC (tools/tft_render.py)
+ *
+ * #includes hlc_tft_display.c, like keymap_host.c does the keymap, so its
+ * widget table and draw functions can be reached, and drives it the way
+ * halcyon.c does: module_post_init_kb() once, then
+ * display_module_housekeeping_task_kb() every ms of a virtual clock. The
+ * panel and Quantum Painter are qp_host.c.
+ *
+ * The RP2040 timer follows the virtual clock, so the display's frame budget
+ * sees every draw as free and the output only depends on the script. Each
+ * draw is timed separately on the host's own clock instead.
+ *
+ * Commands, one per line on stdin:
+ *   layer <n>        layer_state = 1 << n (0 for BASE)
+ *   leds <raw>       host LED state, QMK's led_t bits (1 num, 2 caps, 4 scroll)
+ *   wpm <n>          get_current_wpm()
+ *   seed <n>         entropy pool, what Game of Life gets seeded from
+ *   input            a keypress now (leaves idle mode)
+ *   idle             last keypress IDLE_TIMEOUT + 1 ms ago
+ *   run <ms>         advance the clock, one housekeeping tick per ms
+ *   snap <path>      save the panel, raw RGB565 big endian, row by row
+ *
+ * Output, one line per event:
+ *   T <ms> <widget> <ns>    a widget's draw() and how long it took
+ *   F <ms> <bytes>          pixel bytes sent to the panel in that tick
+ *
+ * With --layers it only prints the layer names, "N <layer> <name>".
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "hlc_tft_display.c"
+
+/* ==========================================================================
+ * QMK
+ * ==========================================================================
+ */
+layer_state_t layer_state = 0;
+layer_state_t default_layer_state = 1;
+
+static uint32_t now_ms = 0;
+static uint32_t last_input_ms = 0;
+static uint8_t wpm = 0;
+static led_t leds = {.raw = 0};
+
+uint8_t get_highest_layer(layer_state_t state) {
+    return state ? 31 - __builtin_clz(state) : 0;
+}
+
+uint16_t timer_read(void) { return (uint16_t)now_ms; }
+uint32_t timer_read32(void) { return now_ms; }
+uint16_t timer_elapsed(uint16_t last) {
+    return TIMER_DIFF_16((uint16_t)now_ms, last);
+}
+uint32_t timer_elapsed32(uint32_t last) {
+    return TIMER_DIFF_32(now_ms, last);
+}
+uint32_t last_input_activity_elapsed(void) { return now_ms - last_input_ms; }
+
+led_t host_keyboard_led_state(void) { return leds; }
+uint8_t get_current_wpm(void) { return wpm; }
+
+void backlight_enable(void) {}
+
+// halcyon.c's weak defaults
+bool module_post_init_user(void) { return true; }
+bool display_module_housekeeping_task_user(bool second_display) {
+    return true;
+}
+
+/* ==========================================================================
+ * RP2040
+ * ==========================================================================
+ */
+static timer_hw_t host_timer;
+timer_hw_t *timer_hw = &host_timer;
+
+static rosc_hw_t host_rosc;
+rosc_hw_t *rosc_hw = &host_rosc;
+
+/* ==========================================================================
+ * DRAW TIMING
+ * ==========================================================================
+ * Every widget's draw() is swapped for a trampoline that times the real
+ * one and reports it.
+ */
+static const struct {
+    void (*draw)(void);
+    const char *name;
+} draw_names[] = {
+    {draw_layer_name, "layer_name"},
+    {draw_layer_fade, "layer_fade"},
+    {draw_locks, "locks"},
+#ifdef HLC_WPM_BIG_DIGITS
+    {draw_wpm_big, "wpm_big"},
+#else
+    {draw_wpm, "wpm"},
+    {draw_tux, "tux"},
+#endif
+    {draw_gol_frame, "gol_frame"},
+};
+
+static void (*widget_draw[NUM_WIDGETS])(void);
+static const char *widget_name[NUM_WIDGETS];
+
+static void timed_draw(uint8_t i) {
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    widget_draw[i]();
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    long ns = (t1.tv_sec - t0.tv_sec) * 1000000000L + t1.tv_nsec - t0.tv_nsec;
+    printf("T %u %s %ld\n", now_ms, widget_name[i], ns);
+}
+
+#define TIMED_DRAW(i)                                                        \
+    static void timed_draw_##i(void) { timed_draw(i); }
+TIMED_DRAW(0)
+TIMED_DRAW(1)
+TIMED_DRAW(2)
+TIMED_DRAW(3)
+TIMED_DRAW(4)
+TIMED_DRAW(5)
+TIMED_DRAW(6)
+TIMED_DRAW(7)
+
+static void (*const trampolines[])(void) = {
+    timed_draw_0, timed_draw_1, timed_draw_2, timed_draw_3,
+    timed_draw_4, timed_draw_5, timed_draw_6, timed_draw_7,
+};
+
+_Static_assert(NUM_WIDGETS <= ARRAY_SIZE(trampolines),
+               "more widgets than draw trampolines");
+
+static void time_widgets(void) {
+    for (uint8_t i = 0; i < NUM_WIDGETS; i++) {
+        widget_draw[i] = widgets[i].draw;
+        widget_name[i] = "?";
+        for (uint8_t n = 0; n < ARRAY_SIZE(draw_names); n++) {
+            if (draw_names[n].draw == widgets[i].draw) {
+                widget_name[i] = draw_names[n].name;
+            }
+        }
+        widgets[i].draw = trampolines[i];
+    }
+}
+
+/* ==========================================================================
+ * MAIN LOOP
+ * ==========================================================================
+ */
+static void tick(void) {
+    now_ms++;
+    timer_hw->timerawl = now_ms * 1000;
+    SPI_DRIVER.state = SPI_READY; // Last tick's transfer is done by now
+
+    uint32_t sent = qp_host_spi_bytes();
+    display_module_housekeeping_task_kb(false);
+    if (qp_host_spi_bytes() != sent) {
+        printf("F %u %u\n", now_ms, qp_host_spi_bytes() - sent);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && !strcmp(argv[1], "--layers")) {
+        for (uint8_t i = 0; i < NUM_LAYERS; i++) {
+            printf("N %u %s\n", i, layer_names[i]);
+        }
+        return 0;
+    }
+
+    if (!module_post_init_kb()) {
+        fprintf(stderr, "tft_host: module_post_init_kb() failed\n");
+        return 1;
+    }
+    time_widgets();
+
+    char line[256];
+    while (fgets(line, sizeof(line), stdin)) {
+        char cmd[16], arg[200] = "";
+        if (sscanf(line, "%15s %199s", cmd, arg) < 1) continue;
+        unsigned long n = strtoul(arg, NULL, 0);
+
+        if (!strcmp(cmd, "layer")) {
+            layer_state = n ? 1UL << n : 0;
+        } else if (!strcmp(cmd, "leds")) {
+            leds.raw = n;
+        } else if (!strcmp(cmd, "wpm")) {
+            wpm = n;
+        } else if (!strcmp(cmd, "seed")) {
+            entropy_pool = n;
+            prng_state = 1;
+        } else if (!strcmp(cmd, "input")) {
+            last_input_ms = now_ms;
+        } else if (!strcmp(cmd, "idle")) {
+            last_input_ms = now_ms - IDLE_TIMEOUT - 1;
+        } else if (!strcmp(cmd, "run")) {
+            for (unsigned long i = 0; i < n; i++) tick();
+        } else if (!strcmp(cmd, "snap")) {
+            if (!qp_host_save_panel(lcd, arg)) {
+                fprintf(stderr, "tft_host: can't write %s\n", arg);
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "tft_host: bad command: %s", line);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,361 @@
+#!/usr/bin/env python3
+# Copyright 2025 naughtyusername
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+# replay.py - Replay key event traces through the userspace on the host
+#
+# Builds naughtyusername.c, numword.c and a keymap (with keyrecords.c and
+# combos.h) against the QMK stand-in in tools/host/, feeds it timestamped
+# key presses and releases, and checks the HID reports that come out -
+# as the text they would type - against what the trace expects. Combos,
+# hold-taps, Caps Word, Num Word and leader sequences all run through the
+# real userspace code, so a change in any of them shows up here first.
+#
+# Needs a C compiler (cc). If users/naughtyusername/secrets.h isn't there, a
+# stand-in with SECRET_EMAIL "you@example.com" is used.
+#
+# Usage:
+#   ./tools/replay.py                          # every tools/traces/*.trace
+#   ./tools/replay.py tools/traces/combos.trace
+#   ./tools/replay.py -v ...                   # also print each report
+#   ./tools/replay.py --feature TYPING_SPEED_TERM ...
+#
+# Trace format:
+#   # Home row roll stays lowercase
+#   case "fj roll"
+#     0 +f          press f, ms from the start of the case
+#    30 +j
+#    60 -f          release f
+#    80 -j
+#   expect "fj"
+#
+# 'expect "fj" by 60' also needs the last key typed by ms 60 of the case.
+# Keys are named by what they type on BASE (f, spc, ent, ;, ...), first
+# match in matrix order, or by position (r6c4 = row 6, col 4). The expected
+# text is plain characters, <C-x> / <A-x> / <G-x> (and <C-S-x>...) for
+# chords, and <esc>, <ent>, <bspc>, <del>, <tab>, <left>, <f1>... for keys
+# without a character. Modifiers on their own don't type anything.
+
+import argparse
+import ast
+import os
+import re
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+REPO = Path(__file__).resolve().parent.parent
+HOST = REPO / "tools" / "host"
+USERSPACE = REPO / "users" / "naughtyusername"
+TRACES = REPO / "tools" / "traces"
+DEFAULT_KEYMAP = (
+    REPO / "keyboards/splitkb/halcyon/corne/rev2/keymaps/naughtyusername"
+)
+
+# Boards the host build knows: keyboard, matrix columns, extra config.h
+# (the Halcyon POST_CONFIG_H has the matrix rows and LAYOUT_corne_hlc)
+BOARDS = {
+    "splitkb/halcyon/corne/rev2": (6, USERSPACE / "splitkb" / "config.h"),
+}
+
+# Userspace rules.mk: on for every keymap
+BASE_FEATURES = [
+    "COMBO_ENABLE",
+    "LEADER_ENABLE",
+    "KEY_OVERRIDE_ENABLE",
+    "CAPS_WORD_ENABLE",
+    "REPEAT_KEY_ENABLE",
+]
+
+# Userspace rules.mk opt-ins: sources and defines each one adds
+OPT_INS = {
+    "COMBO_ADAPTIVE_TERM": (["combo_timing.c"], ["COMBO_ADAPTIVE_TERM"]),
+    "COMBO_STATS": (["combo_stats.c"], ["COMBO_STATS", "RAW_ENABLE"]),
+    "COMBO_EARLY_FIRE": (["combo_early.c"], ["COMBO_EARLY_FIRE"]),
+    "LATENCY_TRACE": (["latency_trace.c"], ["LATENCY_TRACE", "RAW_ENABLE"]),
+    "TYPING_SPEED_TERM": (["typing_speed.c"], ["TYPING_SPEED_TERM"]),
+    "SPECULATIVE_HOLD": ([], ["SPECULATIVE_HOLD"]),
+}
+
+# Case times start here, so nothing happens at timer 0
+START_MS = 1000
+# Clock keeps running this long after a case's last event
+SETTLE_MS = 1000
+
+# HID usage → (name, shifted name). Single characters type themselves.
+HID_NAMES = {0x28: ("ent", None), 0x29: ("esc", None), 0x2A: ("bspc", None),
+             0x2B: ("tab", None), 0x2C: (" ", None), 0x39: ("caps", None),
+             0x46: ("pscr", None), 0x49: ("ins", None), 0x4A: ("home", None),
+             0x4B: ("pgup", None), 0x4C: ("del", None), 0x4D: ("end", None),
+             0x4E: ("pgdn", None), 0x4F: ("right", None),
+             0x50: ("left", None), 0x51: ("down", None), 0x52: ("up", None)}
+for i, c in enumerate("abcdefghijklmnopqrstuvwxyz"):
+    HID_NAMES[0x04 + i] = (c, c.upper())
+for i, (c, s) in enumerate(zip("1234567890", "!@#$%^&*()")):
+    HID_NAMES[0x1E + i] = (c, s)
+for code, c, s in zip([0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x33, 0x34, 0x35,
+                       0x36, 0x37, 0x38], "-=[]\\;'`,./", '_+{}|:"~<>?'):
+    HID_NAMES[code] = (c, s)
+for i in range(12):
+    HID_NAMES[0x3A + i] = (f"f{i + 1}", None)
+
+MOD_CTRL = 0x11
+MOD_SHIFT = 0x22
+MOD_ALT = 0x44
+MOD_GUI = 0x88
+
+
+def key_text(code, mods):
+    name, shifted = HID_NAMES.get(code, (f"0x{code:02x}", None))
+    chord = ""
+    if mods & MOD_CTRL:
+        chord += "C-"
+    if mods & MOD_ALT:
+        chord += "A-"
+    if mods & MOD_GUI:
+        chord += "G-"
+
+    if mods & MOD_SHIFT:
+        if shifted is not None and not chord:
+            return shifted
+        chord += "S-"
+    if chord:
+        return f"<{chord}{name.strip() or 'spc'}>"
+    if len(name) == 1:
+        return name
+    return f"<{name}>"
+
+
+def report_text(reports):
+    """Text typed by a list of (ms, mods, keys) reports."""
+    text = ""
+    held = set()
+    for _, mods, keys in reports:
+        for code in sorted(set(keys) - held):
+            text += key_text(code, mods)
+        held = set(keys)
+    return text
+
+
+def last_typed(reports):
+    """When the last key of a list of reports was typed, 0 if none was."""
+    last = 0
+    held = set()
+    for ms, _, keys in reports:
+        if set(keys) - held:
+            last = ms
+        held = set(keys)
+    return last
+
+
+def read_rules(keymap):
+    """Opt-ins and LEADER_ENABLE as set in the keymap's rules.mk."""
+    rules = {}
+    path = keymap / "rules.mk"
+    if path.exists():
+        for line in path.read_text().splitlines():
+            match = re.match(r"\s*([A-Z_]+)\s*[:?]?=\s*(\w+)", line)
+            if match:
+                rules[match.group(1)] = match.group(2) == "yes"
+    return rules
+
+
+def board_of(keymap):
+    parts = keymap.resolve().relative_to(REPO / "keyboards").parts
+    board = "/".join(parts[: parts.index("keymaps")])
+    if board not in BOARDS:
+        sys.exit(f"{board}: no host build for this board (see BOARDS)")
+    return board
+
+
+def build(keymap, features, workdir):
+    """Compile the host binary for a keymap, return its path."""
+    keymap = Path(keymap).resolve()
+    board = board_of(keymap)
+    cols, board_config = BOARDS[board]
+
+    rules = read_rules(keymap)
+    enabled = set(name for name in OPT_INS if rules.get(name))
+    enabled |= set(features)
+    unknown = enabled - set(OPT_INS)
+    if unknown:
+        sys.exit(f"unknown feature: {', '.join(sorted(unknown))}")
+
+    defines = [f"KEYBOARD_{board.replace('/', '_')}", f"MATRIX_COLS={cols}"]
+    defines += [d for d in BASE_FEATURES
+                if not (d == "LEADER_ENABLE" and rules.get(d) is False)]
+    sources = [HOST / "qmk_host.c", HOST / "keymap_host.c",
+               USERSPACE / "naughtyusername.c", USERSPACE / "numword.c"]
+    for name in sorted(enabled):
+        extra_sources, extra_defines = OPT_INS[name]
+        sources += [USERSPACE / src for src in extra_sources]
+        defines += [d for d in extra_defines if d not in defines]
+
+    includes = [HOST, USERSPACE, keymap]
+    if not (USERSPACE / "secrets.h").exists():
+        (Path(workdir) / "secrets.h").write_text(
+            '#define SECRET_EMAIL "you@example.com"\n')
+        includes.append(Path(workdir))
+
+    binary = Path(workdir) / "qmk_host"
+    cmd = [os.environ.get("CC", "cc"), "-std=gnu11", "-O1", "-g",
+           "-Werror=implicit-function-declaration", "-o", str(binary)]
+    for config in [USERSPACE / "config.h", keymap / "config.h", board_config]:
+        cmd += ["-include", str(config)]
+    cmd += [f"-D{d}" for d in defines]
+    cmd += ['-DQMK_KEYBOARD_H="qmk_host.h"',
+            f'-DKEYMAP_C="{keymap / "keymap.c"}"']
+    cmd += [f"-I{path}" for path in includes]
+    cmd += [str(src) for src in sources]
+
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        sys.exit(f"host build failed:\n{result.stderr}")
+    return binary
+
+
+def key_positions(binary):
+    """BASE layer: key name → (row, col), (row, col) → keycode and hand."""
+    out = subprocess.run([str(binary), "--keys"], capture_output=True,
+                         text=True, check=True).stdout
+    names = {}
+    keycodes = {}
+    hands = {}
+    for line in out.splitlines():
+        _, row, col, keycode, tap, hand = line.split()
+        pos = (int(row), int(col))
+        keycodes[pos] = int(keycode, 16)
+        hands[pos] = hand
+        tap = int(tap, 16)
+        if tap <= 0xFF and tap in HID_NAMES:
+            name = HID_NAMES[tap][0]
+            name = "spc" if name == " " else name
+            names.setdefault(name, pos)
+    return names, keycodes, hands
+
+
+def run(binary, events, end_ms):
+    """Feed (ms, pressed, (row, col)) events, return the output lines."""
+    commands = []
+    for ms, pressed, (row, col) in events:
+        op = "p" if pressed else "r"
+        commands.append(f"{op} {START_MS + ms} {row} {col}")
+    commands.append(f"t {START_MS + end_ms}")
+
+    result = subprocess.run([str(binary)], input="\n".join(commands) + "\n",
+                            capture_output=True, text=True)
+    if result.returncode != 0:
+        sys.exit(f"qmk_host failed:\n{result.stderr}")
+    if result.stderr:
+        print(result.stderr, end="", file=sys.stderr)
+    return result.stdout.splitlines()
+
+
+def parse_reports(lines):
+    reports = []
+    for line in lines:
+        fields = line.split()
+        if fields[0] == "R":
+            reports.append((int(fields[1]) - START_MS, int(fields[2], 16),
+                            [int(code, 16) for code in fields[3:]]))
+    return reports
+
+
+def parse_trace(path, names):
+    """Cases in a trace file: [(name, events, expected text, by ms)]."""
+    cases = []
+    current = None
+    for number, raw in enumerate(Path(path).read_text().splitlines(), 1):
+        line = raw.strip()
+        if not line or line.startswith("#"):
+            continue
+
+        where = f"{path}:{number}"
+        match = re.match(r'(case|expect)\s+(".*?")(?:\s+by\s+(\d+))?$',
+                         line)
+        if match:
+            value = ast.literal_eval(match.group(2))
+            by = int(match.group(3)) if match.group(3) else None
+            if match.group(1) == "case":
+                current = (value, [])
+            elif current is None:
+                sys.exit(f"{where}: expect without a case")
+            else:
+                cases.append((current[0], current[1], value, by))
+                current = None
+            continue
+
+        match = re.match(r"(\d+)\s+([+-])(\S+)\s*(#.*)?$", line)
+        if not match or current is None:
+            sys.exit(f"{where}: can't parse '{raw.strip()}'")
+        ms, sign, key = int(match.group(1)), match.group(2), match.group(3)
+        pos = re.match(r"r(\d+)c(\d+)$", key)
+        if pos:
+            key_pos = (int(pos.group(1)), int(pos.group(2)))
+        elif key in names:
+            key_pos = names[key]
+        else:
+            sys.exit(f"{where}: no key '{key}' on BASE")
+        current[1].append((ms, sign == "+", key_pos))
+    if current is not None:
+        sys.exit(f"{path}: case '{current[0]}' has no expect")
+    return cases
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("traces", nargs="*", type=Path,
+                        help="trace files (default: tools/traces/*.trace)")
+    parser.add_argument("--keymap", type=Path, default=DEFAULT_KEYMAP,
+                        help="keymap directory to build")
+    parser.add_argument("--feature", action="append", default=[],
+                        help="turn on a userspace opt-in, e.g. "
+                             "TYPING_SPEED_TERM")
+    parser.add_argument("-v", "--verbose", action="store_true",
+                        help="print the reports of every case")
+    args = parser.parse_args()
+
+    traces = args.traces or sorted(TRACES.glob("*.trace"))
+    failed = 0
+    total = 0
+    with tempfile.TemporaryDirectory() as workdir:
+        binary = build(args.keymap, args.feature, workdir)
+        names, _, _ = key_positions(binary)
+
+        for trace in traces:
+            for name, events, expected, by in parse_trace(trace, names):
+                end = max(ms for ms, _, _ in events) + SETTLE_MS
+                lines = run(binary, events, end)
+                reports = parse_reports(lines)
+                got = report_text(reports)
+                last = last_typed(reports)
+
+                total += 1
+                if got == expected and (by is None or last <= by):
+                    print(f"ok    {trace.name}: {name}")
+                elif got == expected:
+                    failed += 1
+                    print(f"FAIL  {trace.name}: {name}\n"
+                          f"      expected by {by} ms\n"
+                          f"      got      at {last} ms")
+                else:
+                    failed += 1
+                    print(f"FAIL  {trace.name}: {name}\n"
+                          f"      expected {expected!r}\n"
+                          f"      got      {got!r}")
+                if args.verbose:
+                    for line in lines:
+                        fields = line.split()
+                        if fields[0] in "RLE":
+                            fields[1] = str(int(fields[1]) - START_MS)
+                        if fields[0] == "E":
+                            fields[2] = str(int(fields[2]) - START_MS)
+                        print("      " + " ".join(fields))
+
+    print(f"{total - failed}/{total} cases passed")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
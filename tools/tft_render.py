@@ -0,0 +1,326 @@
+#!/usr/bin/env python3
+# Copyright 2025 naughtyusername
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+# tft_render.py - Render the Halcyon TFT display on the host, check it
+# against golden images, and time every draw
+#
+# Builds hlc_tft_display.c against the Quantum Painter stand-in in
+# tools/host/ (qp_host.c, tft_host.c): the real fonts, images, palette
+# framebuffer, dirty bands and flush, with a "panel" that keeps whatever
+# the flush sends it over SPI. Each scene below is scripted from boot, the
+# panel is saved as a PNG and compared with tools/tft_golden/<variant>/.
+#
+# Scenes:
+#   layer-<n>-<name>   every layer, after its fade has finished
+#   locks-<c|n|s...>   every Caps / Num / Scroll Lock combination
+#   wpm-<n>            a few WPM values
+#   gol-<nn>           Game of Life generations from --seed
+#
+# Every draw() the widget scheduler makes is timed on the host (so the
+# numbers are for comparing changes, not RP2040 microseconds), and the
+# bytes each tick sends to the panel are counted.
+#
+# Usage:
+#   ./tools/tft_render.py                   # check every scene, print timing
+#   ./tools/tft_render.py --update          # rewrite the goldens
+#   ./tools/tft_render.py --scene 'wpm-*' --out /tmp/tft
+#   ./tools/tft_render.py --big-digits      # HLC_WPM_BIG_DIGITS variant
+#   ./tools/tft_render.py --gol 50 --seed 7 --no-check
+
+import argparse
+import fnmatch
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+import zlib
+from pathlib import Path
+
+import replay
+
+DISPLAY = replay.USERSPACE / "splitkb" / "hlc_tft_display"
+GRAPHICS = DISPLAY / "graphics"
+GOLDEN = replay.REPO / "tools" / "tft_golden"
+
+WIDTH = 135
+HEIGHT = 240
+
+# Long enough for the boot frame, a layer fade and the 250ms WPM limit
+SETTLE_MS = 1000
+GOL_FRAME_MS = 100
+
+WPM_VALUES = [0, 7, 42, 100, 255]
+LOCK_BITS = [("n", 1), ("c", 2), ("s", 4)]  # QMK led_t
+
+
+def build(keymap, big_digits, workdir):
+    """Compile the display host binary, return its path."""
+    keymap = Path(keymap).resolve()
+    board = replay.board_of(keymap)
+    cols, board_config = replay.BOARDS[board]
+
+    defines = [f"KEYBOARD_{board.replace('/', '_')}", f"MATRIX_COLS={cols}",
+               "WPM_ENABLE"] + replay.BASE_FEATURES
+    sources = [replay.HOST / "tft_host.c", replay.HOST / "qp_host.c",
+               GRAPHICS / "fonts" / "Retron2000-27.qff.c",
+               GRAPHICS / "fonts" / "Retron2000-underline-27.qff.c"]
+    if big_digits:
+        defines.append("HLC_WPM_BIG_DIGITS")
+        sources += [GRAPHICS / "numbers" / f"{i}.qgf.c" for i in range(10)]
+    else:
+        sources.append(GRAPHICS / "tux_100.qgf.c")
+
+    includes = [replay.HOST, replay.USERSPACE, replay.USERSPACE / "splitkb",
+                DISPLAY, keymap]
+    if not (replay.USERSPACE / "secrets.h").exists():
+        (Path(workdir) / "secrets.h").write_text(
+            '#define SECRET_EMAIL "you@example.com"\n')
+        includes.append(Path(workdir))
+
+    binary = Path(workdir) / "tft_host"
+    cmd = [os.environ.get("CC", "cc"), "-std=gnu11", "-O2", "-g",
+           "-Werror=implicit-function-declaration", "-o", str(binary)]
+    for config in [replay.USERSPACE / "config.h", keymap / "config.h",
+                   board_config, DISPLAY / "config.h"]:
+        cmd += ["-include", str(config)]
+    cmd += [f"-D{d}" for d in defines]
+    cmd += ['-DQMK_KEYBOARD_H="qmk_host.h"']
+    cmd += [f"-I{path}" for path in includes]
+    cmd += [str(src) for src in sources]
+
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        sys.exit(f"host build failed:\n{result.stderr}")
+    return binary
+
+
+def layer_names(binary):
+    out = subprocess.run([str(binary), "--layers"], capture_output=True,
+                         text=True, check=True).stdout
+    return [line.split()[2] for line in out.splitlines()]
+
+
+def scenes(names, generations, seed):
+    """Scripts to run, from boot. Each snap in them names a scene."""
+    out = []
+    for layer, name in enumerate(names):
+        out.append([f"run {SETTLE_MS}", "input", f"layer {layer}",
+                    f"run {SETTLE_MS}", f"snap layer-{layer}-{name.lower()}"])
+    for mask in range(8):
+        locks = "".join(c for c, bit in LOCK_BITS if mask & bit) or "none"
+        out.append([f"run {SETTLE_MS}", "input", f"leds {mask}",
+                    f"run {SETTLE_MS}", f"snap locks-{locks}"])
+    for wpm in WPM_VALUES:
+        out.append([f"run {SETTLE_MS}", "input", f"wpm {wpm}",
+                    f"run {SETTLE_MS}", f"snap wpm-{wpm}"])
+
+    # Idle from the first tick, so generation 0 is drawn at GOL_FRAME_MS.
+    # Snap each one just before the next, when its flush has long finished.
+    gol = [f"seed {seed}", "idle", f"run {2 * GOL_FRAME_MS - 1}"]
+    for i in range(generations):
+        gol += [f"snap gol-{i:02d}", f"run {GOL_FRAME_MS}"]
+    out.append(gol)
+    return out
+
+
+def render(binary, commands, workdir):
+    """Run one script: ({scene: rgb bytes}, output lines)."""
+    snaps = {}
+    script = []
+    for command in commands:
+        if command.startswith("snap "):
+            name = command.split()[1]
+            snaps[name] = Path(workdir) / f"{name}.raw"
+            command = f"snap {snaps[name]}"
+        script.append(command)
+
+    result = subprocess.run([str(binary)], input="\n".join(script) + "\n",
+                            capture_output=True, text=True)
+    if result.returncode != 0:
+        sys.exit(f"tft_host failed:\n{result.stderr}")
+    return ({name: rgb565_to_rgb(path.read_bytes())
+             for name, path in snaps.items()},
+            result.stdout.splitlines())
+
+
+def rgb565_to_rgb(raw):
+    out = bytearray()
+    for (value,) in struct.iter_unpack(">H", raw):
+        r, g, b = value >> 11, (value >> 5) & 0x3F, value & 0x1F
+        out += bytes(((r << 3) | (r >> 2), (g << 2) | (g >> 4),
+                      (b << 3) | (b >> 2)))
+    return bytes(out)
+
+
+# ==========================================================================
+# PNG
+# ==========================================================================
+# 8-bit RGB, no filtering. Reading only has to handle what write_png makes.
+
+def png_chunk(kind, data):
+    return (struct.pack(">I", len(data)) + kind + data +
+            struct.pack(">I", zlib.crc32(kind + data)))
+
+
+def write_png(path, rgb):
+    stride = WIDTH * 3
+    rows = b"".join(b"\0" + rgb[y * stride:(y + 1) * stride]
+                    for y in range(HEIGHT))
+    header = struct.pack(">IIBBBBB", WIDTH, HEIGHT, 8, 2, 0, 0, 0)
+    Path(path).write_bytes(b"\x89PNG\r\n\x1a\n" +
+                           png_chunk(b"IHDR", header) +
+                           png_chunk(b"IDAT", zlib.compress(rows, 9)) +
+                           png_chunk(b"IEND", b""))
+
+
+def read_png(path):
+    data = Path(path).read_bytes()
+    at = 8
+    idat = b""
+    header = None
+    while at < len(data):
+        length, kind = struct.unpack(">I4s", data[at:at + 8])
+        body = data[at + 8:at + 8 + length]
+        if kind == b"IHDR":
+            header = struct.unpack(">IIBBBBB", body)
+        elif kind == b"IDAT":
+            idat += body
+        at += 12 + length
+    if header != (WIDTH, HEIGHT, 8, 2, 0, 0, 0):
+        sys.exit(f"{path}: not a {WIDTH}x{HEIGHT} RGB PNG from this tool")
+
+    rows = zlib.decompress(idat)
+    stride = WIDTH * 3 + 1
+    if any(rows[y * stride] for y in range(HEIGHT)):
+        sys.exit(f"{path}: filtered PNG, regenerate it with --update")
+    return b"".join(rows[y * stride + 1:(y + 1) * stride]
+                    for y in range(HEIGHT))
+
+
+def diff_image(want, got):
+    """Dimmed golden with the differing pixels in red, and their count."""
+    out = bytearray(len(got))
+    changed = 0
+    for i in range(0, len(got), 3):
+        if want[i:i + 3] == got[i:i + 3]:
+            out[i:i + 3] = bytes(c // 4 for c in want[i:i + 3])
+        else:
+            out[i:i + 3] = b"\xff\x00\x00"
+            changed += 1
+    return bytes(out), changed
+
+
+# ==========================================================================
+# TIMING
+# ==========================================================================
+
+def percentile(values, p):
+    """Nearest-rank percentile."""
+    ordered = sorted(values)
+    rank = max(0, min(len(ordered) - 1, round(p / 100 * len(ordered)) - 1))
+    return ordered[rank]
+
+
+def print_timing(lines):
+    draws = {}
+    flushed = []
+    for line in lines:
+        fields = line.split()
+        if fields[0] == "T":
+            draws.setdefault(fields[2], []).append(int(fields[3]) / 1000)
+        elif fields[0] == "F":
+            flushed.append(int(fields[2]))
+
+    print(f"\n{'draw':<12} {'n':>6} {'mean':>8} {'p50':>8} {'p99':>8} "
+          f"{'max':>8}  us (host)")
+    for name, times in sorted(draws.items()):
+        print(f"{name:<12} {len(times):6d} {sum(times) / len(times):8.1f} "
+              f"{percentile(times, 50):8.1f} {percentile(times, 99):8.1f} "
+              f"{max(times):8.1f}")
+    if flushed:
+        print(f"\nflush: {len(flushed)} ticks sent pixels, "
+              f"mean {sum(flushed) // len(flushed)} bytes, "
+              f"max {max(flushed)} bytes per tick")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--keymap", type=Path, default=replay.DEFAULT_KEYMAP,
+                        help="keymap directory to build")
+    parser.add_argument("--big-digits", action="store_true",
+                        help="build with HLC_WPM_BIG_DIGITS")
+    parser.add_argument("--scene", action="append", default=[],
+                        help="only scenes matching this pattern, e.g. 'wpm-*'")
+    parser.add_argument("--gol", type=int, default=8,
+                        help="Game of Life generations (default 8)")
+    parser.add_argument("--seed", type=int, default=1,
+                        help="Game of Life entropy pool (default 1)")
+    parser.add_argument("--update", action="store_true",
+                        help="write the renders as the new goldens")
+    parser.add_argument("--no-check", action="store_true",
+                        help="don't compare, just render and time")
+    parser.add_argument("--out", type=Path,
+                        help="also save every render (and diffs) here")
+    parser.add_argument("--no-timing", action="store_true",
+                        help="skip the draw timing table")
+    args = parser.parse_args()
+
+    variant = "big-digits" if args.big_digits else "tux"
+    golden = GOLDEN / variant
+    wanted = lambda name: not args.scene or any(
+        fnmatch.fnmatch(name, pattern) for pattern in args.scene)
+
+    failed = 0
+    total = 0
+    lines = []
+    with tempfile.TemporaryDirectory() as workdir:
+        binary = build(args.keymap, args.big_digits, workdir)
+        for commands in scenes(layer_names(binary), args.gol, args.seed):
+            names = [c.split()[1] for c in commands if c.startswith("snap ")]
+            if not any(wanted(name) for name in names):
+                continue
+            renders, output = render(binary, commands, workdir)
+            lines += output
+
+            for name, rgb in renders.items():
+                if not wanted(name):
+                    continue
+                total += 1
+                path = golden / f"{name}.png"
+                if args.out:
+                    args.out.mkdir(parents=True, exist_ok=True)
+                    write_png(args.out / f"{name}.png", rgb)
+                if args.update:
+                    golden.mkdir(parents=True, exist_ok=True)
+                    write_png(path, rgb)
+                    print(f"wrote {path.relative_to(replay.REPO)}")
+                    continue
+                if args.no_check:
+                    continue
+                if not path.exists():
+                    failed += 1
+                    print(f"FAIL  {name}: no golden (run with --update)")
+                    continue
+
+                diff, changed = diff_image(read_png(path), rgb)
+                if not changed:
+                    print(f"ok    {name}")
+                    continue
+                failed += 1
+                print(f"FAIL  {name}: {changed} pixels differ")
+                if args.out:
+                    write_png(args.out / f"{name}.diff.png", diff)
+
+    if not args.no_timing:
+        print_timing(lines)
+    if not (args.update or args.no_check):
+        print(f"\n{total - failed}/{total} scenes match ({variant})")
+        if failed and not args.out:
+            print("rerun with --out DIR to see the renders and diffs")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
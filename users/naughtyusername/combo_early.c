@@ -0,0 +1,82 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * combo_early.c - Fire terminal combos as soon as their keys are down
+ *
+ * QMK holds a readied combo until the longest term of every combo the
+ * buffered keys touched has run out, in case a bigger combo is still on
+ * its way. When no superset of the combo is live on the current layer
+ * (combo_is_terminal(), superset graph in combos.h) nothing can change the
+ * outcome any more, so that wait is pure latency - up to COMBO_SLOW for CV
+ * or VB.
+ *
+ * No combo callback can say "fire now", but process_combo() applies
+ * whatever it has buffered as soon as it sees an event that isn't a combo
+ * key press - the same thing a typed-through key does. So a press marks
+ * the engine dirty from pre_process_record_user(), and by
+ * housekeeping_task_user() the engine has buffered it. If a terminal combo
+ * then has every key down and is neither active nor disabled (timed out,
+ * or turned down by combo_should_trigger), a tick event is fed to
+ * process_combo() to apply it.
+ *
+ * Must-tap combos are left alone: a tap is only known on release, and
+ * apply_combos() drops them anyway. That rules out everything with a home
+ * row mod in it (HJ, JK, DF, ...). Must-hold combos are timed on purpose.
+ *
+ * This reads combo_t's state / active / disabled, which are QMK's own
+ * bookkeeping - recheck it after a QMK update.
+ */
+
+#include "combo_early.h"
+
+#ifdef EXTRA_SHORT_COMBOS
+#    error "COMBO_EARLY_FIRE needs combo_t's active / disabled flags"
+#endif
+
+static bool key_pressed = false;
+
+// Every key of the combo is down and the engine has it buffered
+static bool combo_ready(const combo_t *combo) {
+    uint8_t count = 0;
+    while (pgm_read_word(&combo->keys[count]) != COMBO_END)
+        count++;
+
+    return combo->state == (1 << count) - 1 && !combo->active &&
+           !combo->disabled;
+}
+
+/* ==========================================================================
+ * PUBLIC API
+ * ==========================================================================
+ */
+
+/**
+ * Called from pre_process_record_user() for every raw event, before the
+ * combo engine sees it.
+ */
+void process_combo_early(keyrecord_t *record) {
+    if (IS_KEYEVENT(record->event) && record->event.pressed)
+        key_pressed = true;
+}
+
+/**
+ * Applies a readied terminal combo. Called from housekeeping_task_user().
+ */
+void combo_early_task(void) {
+    if (!key_pressed)
+        return;
+    key_pressed = false;
+
+    uint16_t count = combo_count();
+    for (uint16_t c = 0; c < count; c++) {
+        combo_t *combo = combo_get(c);
+        if (!combo_ready(combo) || get_combo_must_tap(c, combo) ||
+            get_combo_must_hold(c, combo) || !combo_is_terminal(c))
+            continue;
+
+        // Not a combo key press, so the engine applies its buffer now
+        keyrecord_t tick = {.event = MAKE_TICK_EVENT};
+        process_combo(KC_NO, &tick);
+        return;
+    }
+}
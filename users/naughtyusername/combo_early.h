@@ -0,0 +1,18 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * combo_early.h - Fire terminal combos without waiting out the term (opt-in)
+ *
+ * Enable with COMBO_EARLY_FIRE = yes in rules.mk. See combo_early.c for
+ * which combos it applies to and how the engine is made to fire them.
+ */
+
+#pragma once
+
+#include "naughtyusername.h"
+
+// No live superset combo on the current layer (superset graph in combos.h)
+bool combo_is_terminal(uint16_t combo_index);
+
+void process_combo_early(keyrecord_t *record);
+void combo_early_task(void);
@@ -0,0 +1,322 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * combo_stats.c - Per-combo hit / miss telemetry
+ *
+ * Tuning combo windows (especially the FAST top row, where QW_NEQL /
+ * QW_OSM_LGUI and ER_REPEAT / ER_OSM_LCTL share keys) is guesswork without
+ * numbers. This keeps four counters per combo:
+ *
+ *   FIRED     process_combo_event(pressed) - the combo actually went off
+ *   TIMEOUT   every key went down together on a live layer, but first →
+ *             last press took longer than the combo's term (you went for
+ *             it, too slowly). A round where one of its keys came up, or
+ *             another key went down, before the last press is typing, not
+ *             a combo attempt, and isn't counted.
+ *   REJECTED  every key went down within the term, but combo_should_trigger
+ *             said no (wrong layer)
+ *   RELEASED  every key went down within the term on a live layer, then a
+ *             key came up before the term ran out and the combo never fired
+ *             (e.g. a must-hold combo let go too early)
+ *
+ * Raw presses are watched from pre_process_record_user(), ahead of the
+ * combo engine, against BASE keycodes like the engine matches them.
+ * RELEASED is settled one housekeeping tick after the release, because the
+ * engine may still fire the combo on that same release.
+ *
+ * Counters live in RAM, saturate at 65535, and are written to the EEPROM
+ * user datablock every COMBO_STATS_FLUSH_INTERVAL when they changed.
+ *
+ * RAW HID PROTOCOL (32 byte packets, byte 0 = command id, echoed back)
+ *   INFO    → [1] status, [2] combo count, [3] stats per combo
+ *   READ    [1] first combo → [1] status, [2] first, [3] n,
+ *                             [4..] n x COMBO_STAT_COUNT little-endian u16
+ *   NAME    [1] combo       → [1] status, [2..] NUL terminated name
+ *   RESET   → [1] status
+ */
+
+#include "combo_stats.h"
+
+#define COMBO_STATS_MAGIC 0xC057
+#define COMBO_STATS_VERSION 1
+
+enum combo_stats_flag {
+    FLAG_COMPLETE = 1 << 0, // every key has gone down this round
+    FLAG_ARMED = 1 << 1,    // ...within the term on a live layer
+    FLAG_FIRED = 1 << 2,    // process_combo_event fired this round
+    FLAG_PENDING = 1 << 3,  // released early, settle in the task
+    FLAG_ROLLED = 1 << 4,   // a key came up / other key went down mid-round
+};
+
+typedef struct {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t count;
+    uint16_t counters[COMBO_STATS_MAX_COMBOS][COMBO_STAT_COUNT];
+} combo_stats_eeprom_t;
+
+_Static_assert(sizeof(combo_stats_eeprom_t) <= COMBO_STATS_EEPROM_SIZE,
+               "COMBO_STATS_EEPROM_SIZE too small for the counters");
+
+static combo_stats_eeprom_t store;
+
+static struct {
+    uint16_t first; // first press time this round
+    uint16_t last;  // latest press time this round
+    uint8_t down;   // bit per combo key index
+    uint8_t flags;
+} rounds[COMBO_STATS_MAX_COMBOS];
+
+static bool stats_dirty = false;
+static bool any_pending = false;
+static uint32_t flush_timer = 0;
+
+/* ==========================================================================
+ * HELPERS
+ * ==========================================================================
+ */
+
+// Key index of `keycode` in the combo and the combo's full key mask
+static int8_t combo_key_index(const combo_t *combo, uint16_t keycode,
+                              uint8_t *full) {
+    int8_t index = -1;
+    uint8_t i = 0;
+
+    for (;; i++) {
+        uint16_t key = pgm_read_word(&combo->keys[i]);
+        if (key == COMBO_END)
+            break;
+        if (key == keycode)
+            index = i;
+    }
+    *full = (1 << i) - 1;
+    return index;
+}
+
+static void bump(uint16_t combo_index, enum combo_stat stat) {
+    uint16_t *counter = &store.counters[combo_index][stat];
+    if (*counter < UINT16_MAX) {
+        (*counter)++;
+        stats_dirty = true;
+    }
+}
+
+static void on_press(uint8_t c, combo_t *combo, uint8_t bit, uint8_t full,
+                     uint16_t keycode, keyrecord_t *record) {
+    uint16_t now = record->event.time;
+
+    if (!rounds[c].down) {
+        rounds[c].first = now;
+        rounds[c].flags &= FLAG_PENDING; // keep an unsettled release
+    }
+    rounds[c].down |= bit;
+    rounds[c].last = now;
+
+    if (rounds[c].down != full || (rounds[c].flags & FLAG_COMPLETE))
+        return;
+
+    rounds[c].flags |= FLAG_COMPLETE;
+    bool in_time =
+        TIMER_DIFF_16(now, rounds[c].first) <= get_combo_term(c, combo);
+    if (!combo_should_trigger(c, combo, keycode, record)) {
+        if (in_time)
+            bump(c, COMBO_STAT_REJECTED);
+    } else if (!in_time) {
+        if (!(rounds[c].flags & FLAG_ROLLED))
+            bump(c, COMBO_STAT_TIMEOUT);
+    } else {
+        rounds[c].flags |= FLAG_ARMED;
+    }
+}
+
+static void on_release(uint8_t c, combo_t *combo, uint8_t bit,
+                       keyrecord_t *record) {
+    uint8_t flags = rounds[c].flags;
+
+    if ((flags & FLAG_ARMED) && !(flags & FLAG_FIRED) &&
+        TIMER_DIFF_16(record->event.time, rounds[c].last) <
+            get_combo_term(c, combo)) {
+        rounds[c].flags |= FLAG_PENDING;
+        any_pending = true;
+    }
+    // Only the first release of a round can be "early"
+    rounds[c].flags &= ~FLAG_ARMED;
+    if (!(flags & FLAG_COMPLETE))
+        rounds[c].flags |= FLAG_ROLLED;
+    rounds[c].down &= ~bit;
+}
+
+/* ==========================================================================
+ * RAW HID
+ * ==========================================================================
+ */
+enum combo_stats_command {
+    COMBO_STATS_CMD_INFO = 0x40,
+    COMBO_STATS_CMD_READ,
+    COMBO_STATS_CMD_NAME,
+    COMBO_STATS_CMD_RESET,
+};
+
+enum combo_stats_status {
+    COMBO_STATS_OK = 0,
+    COMBO_STATS_BAD_INDEX,
+};
+
+#define COMBO_STATS_PER_PACKET ((RAW_EPSIZE - 4) / (COMBO_STAT_COUNT * 2))
+
+/**
+ * Handle a combo stats command in place. Returns false if `data` isn't
+ * one of ours, so the dispatcher can try the next handler.
+ */
+bool combo_stats_raw_hid(uint8_t *data, uint8_t length) {
+    uint16_t count = combo_count();
+    uint8_t index = data[1];
+
+    switch (data[0]) {
+    case COMBO_STATS_CMD_INFO:
+        memset(&data[1], 0, length - 1);
+        data[1] = COMBO_STATS_OK;
+        data[2] = count;
+        data[3] = COMBO_STAT_COUNT;
+        return true;
+
+    case COMBO_STATS_CMD_READ: {
+        memset(&data[1], 0, length - 1);
+        if (index >= count) {
+            data[1] = COMBO_STATS_BAD_INDEX;
+            return true;
+        }
+        uint8_t n = MIN(count - index, COMBO_STATS_PER_PACKET);
+        uint8_t *out = &data[4];
+        data[1] = COMBO_STATS_OK;
+        data[2] = index;
+        data[3] = n;
+        for (uint8_t c = index; c < index + n; c++) {
+            for (uint8_t s = 0; s < COMBO_STAT_COUNT; s++) {
+                *out++ = store.counters[c][s] & 0xFF;
+                *out++ = store.counters[c][s] >> 8;
+            }
+        }
+        return true;
+    }
+
+    case COMBO_STATS_CMD_NAME:
+        memset(&data[1], 0, length - 1);
+        if (index >= count) {
+            data[1] = COMBO_STATS_BAD_INDEX;
+            return true;
+        }
+        data[1] = COMBO_STATS_OK;
+        const char *name = combo_name(index);
+        for (uint8_t i = 2; i < length - 1; i++) {
+            char ch = pgm_read_byte(name++);
+            if (!ch)
+                break;
+            data[i] = ch;
+        }
+        return true;
+
+    case COMBO_STATS_CMD_RESET:
+        combo_stats_reset();
+        memset(&data[1], 0, length - 1);
+        data[1] = COMBO_STATS_OK;
+        return true;
+    }
+    return false;
+}
+
+/* ==========================================================================
+ * PUBLIC API
+ * ==========================================================================
+ */
+
+/**
+ * Called from pre_process_record_user() for every raw event, before the
+ * combo engine sees it.
+ */
+void process_combo_stats(keyrecord_t *record) {
+    if (!IS_KEYEVENT(record->event))
+        return;
+
+    uint16_t keycode =
+        keymap_key_to_keycode(COMBO_ONLY_FROM_LAYER, record->event.key);
+    uint16_t count = combo_count();
+
+    for (uint8_t c = 0; c < count; c++) {
+        combo_t *combo = combo_get(c);
+        uint8_t full;
+        int8_t index = combo_key_index(combo, keycode, &full);
+
+        if (index < 0) {
+            // Some other key in the middle of a round - that's typing
+            if (record->event.pressed && rounds[c].down)
+                rounds[c].flags |= FLAG_ROLLED;
+            continue;
+        }
+        if (record->event.pressed) {
+            on_press(c, combo, 1 << index, full, keycode, record);
+        } else {
+            on_release(c, combo, 1 << index, record);
+        }
+    }
+}
+
+/**
+ * Called from process_combo_event() on press, for every combo that fires.
+ */
+void combo_stats_fired(uint16_t combo_index) {
+    if (combo_index >= COMBO_STATS_MAX_COMBOS)
+        return;
+    rounds[combo_index].flags |= FLAG_FIRED;
+    bump(combo_index, COMBO_STAT_FIRED);
+}
+
+void combo_stats_reset(void) {
+    memset(&store, 0, sizeof(store));
+    store.magic = COMBO_STATS_MAGIC;
+    store.version = COMBO_STATS_VERSION;
+    store.count = combo_count();
+    eeconfig_update_user_datablock(&store, COMBO_STATS_EEPROM_OFFSET,
+                                   sizeof(store));
+    stats_dirty = false;
+}
+
+void combo_stats_init(void) {
+    eeconfig_read_user_datablock(&store, COMBO_STATS_EEPROM_OFFSET,
+                                 sizeof(store));
+
+    // Counters are per index, so a different combo count means they no
+    // longer line up with combos.def
+    if (store.magic != COMBO_STATS_MAGIC ||
+        store.version != COMBO_STATS_VERSION || store.count != combo_count()) {
+        combo_stats_reset();
+    }
+    flush_timer = timer_read32();
+}
+
+/**
+ * Settles early releases and does the periodic EEPROM write-back. Called
+ * from housekeeping_task_user().
+ */
+void combo_stats_task(void) {
+    if (any_pending) {
+        uint16_t count = combo_count();
+        for (uint8_t c = 0; c < count; c++) {
+            if (!(rounds[c].flags & FLAG_PENDING))
+                continue;
+            if (!(rounds[c].flags & FLAG_FIRED))
+                bump(c, COMBO_STAT_RELEASED);
+            rounds[c].flags &= ~FLAG_PENDING;
+        }
+        any_pending = false;
+    }
+
+    if (!stats_dirty ||
+        timer_elapsed32(flush_timer) < COMBO_STATS_FLUSH_INTERVAL)
+        return;
+
+    eeconfig_update_user_datablock(&store, COMBO_STATS_EEPROM_OFFSET,
+                                   sizeof(store));
+    stats_dirty = false;
+    flush_timer = timer_read32();
+}
@@ -0,0 +1,35 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * combo_stats.h - Per-combo hit / miss counters (opt-in)
+ *
+ * Enable with COMBO_STATS = yes in rules.mk. Read them with
+ * tools/combo_stats.py over raw HID.
+ */
+
+#pragma once
+
+#include "naughtyusername.h"
+
+// How often counters are written back to EEPROM (only if changed)
+#ifndef COMBO_STATS_FLUSH_INTERVAL
+#    define COMBO_STATS_FLUSH_INTERVAL 300000
+#endif
+
+enum combo_stat {
+    COMBO_STAT_FIRED,    // combo went off
+    COMBO_STAT_TIMEOUT,  // all keys down together, spread longer than term
+    COMBO_STAT_REJECTED, // all keys down in time, layer filter said no
+    COMBO_STAT_RELEASED, // all keys down in time, let go early, never fired
+    COMBO_STAT_COUNT,
+};
+
+// Name of a combo as written in combos.def (defined in combos.h)
+const char *combo_name(uint16_t combo_index);
+
+void combo_stats_init(void);
+void combo_stats_reset(void);
+void combo_stats_task(void);
+void combo_stats_fired(uint16_t combo_index);
+void process_combo_stats(keyrecord_t *record);
+bool combo_stats_raw_hid(uint8_t *data, uint8_t length);
@@ -0,0 +1,402 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * combo_timing.c - Adaptive combo term learned from real typing
+ *
+ * COMBO_FAST/MED/SLOW are fixed windows. Every key that starts a combo makes
+ * QMK wait that long before it knows the press is "just a letter", so a
+ * tighter window is directly less lag on ordinary typing. This module
+ * watches raw presses on combo keys and learns, per combo, how tightly the
+ * intentional chords actually land, then narrows the term towards that.
+ *
+ * HOW A SAMPLE IS TAKEN
+ * Raw key events come in via pre_process_record_user(), which QMK calls
+ * BEFORE the combo engine buffers anything, so event.time is the real
+ * matrix time. When the first key of a fully-held combo is released:
+ *
+ *   spread  = last press - first press   (how tightly the keys landed)
+ *   overlap = first release - last press (how long they were all down)
+ *
+ *   overlap >  spread  → CHORD  (keys went down together and stayed down)
+ *   overlap <= spread  → ROLL   (a normal bigram: "we", "er", "ui"...)
+ *
+ * This doesn't depend on whether the combo actually fired, so a narrowed
+ * term can't talk itself into narrowing further.
+ *
+ * HOW THE TERM IS DERIVED
+ * Per combo we keep an exponential moving average (1/8 weight, Q4 fixed
+ * point) and mean absolute deviation of chord spreads and roll spreads:
+ *
+ *   upper = chord avg + DEV_MULT * chord dev + MARGIN  (catches the chords)
+ *   lower = roll avg - 2 * roll dev                    (most rolls are slower)
+ *
+ * If there is a gap between the two the term sits in the middle of it,
+ * otherwise at `upper` (missing a chord is worse than the odd misfire).
+ * The result is clamped to [COMBO_TIMING_MIN_TERM, tier term] - learning
+ * can only ever tighten a combo, never loosen it past combos.def.
+ *
+ * SHARED KEYS
+ * Combos in the same tier that share a physical key must keep identical
+ * terms (see the top row note in combos.def). Along a chain like QW-WE-ER
+ * that equality carries over from pair to pair, so the groups are the
+ * transitive closure of "shares a key", built at boot, and every member
+ * of a group uses the group's widest term.
+ *
+ * A combo only brings a learned term to its group once it has
+ * COMBO_TIMING_MIN_SAMPLES chords of its own; until then it counts at its
+ * tier term. So a group narrows only when every member has been taught,
+ * and no combo runs on timing learned from a different combo.
+ *
+ * Learned stats persist in the EEPROM user datablock and are reset by
+ * EE_CLR. A changed combos.def (different keys or count) also resets them.
+ */
+
+#include "combo_timing.h"
+
+#define COMBO_TIMING_MAGIC 0xC7A1
+#define COMBO_TIMING_VERSION 1
+
+// Q4 fixed point: 16 units per ms
+#define Q4(ms) ((uint16_t)(ms) << 4)
+
+// Spreads above this are ignored - neither a chord nor a combo-speed roll
+#define COMBO_TIMING_WINDOW 64
+
+// Keys being tracked as held. Combos are at most 4 keys, 8 covers rollover.
+#define COMBO_TIMING_HELD_MAX 8
+
+typedef struct {
+    uint16_t chord_avg; // Q4 ms
+    uint16_t chord_dev; // Q4 ms
+    uint16_t roll_avg;  // Q4 ms
+    uint16_t roll_dev;  // Q4 ms
+    uint8_t chord_n;    // saturating sample counts
+    uint8_t roll_n;
+} combo_timing_stats_t;
+
+typedef struct {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t count;
+    uint16_t spec_hash; // hash of every combo's keys, see combo_spec_hash()
+    uint16_t reserved;
+    combo_timing_stats_t stats[COMBO_TIMING_MAX_COMBOS];
+} combo_timing_eeprom_t;
+
+_Static_assert(sizeof(combo_timing_eeprom_t) <= COMBO_TIMING_EEPROM_SIZE,
+               "COMBO_TIMING_EEPROM_SIZE too small for the stats block");
+
+static combo_timing_eeprom_t store;
+
+// Published term per combo (0 = not computed yet, use the tier term)
+static uint8_t terms[COMBO_TIMING_MAX_COMBOS];
+
+// Group leader per combo, for the shared-key rule
+static uint8_t group[COMBO_TIMING_MAX_COMBOS];
+
+static struct {
+    uint16_t keycode;
+    uint16_t time;
+} held[COMBO_TIMING_HELD_MAX];
+static uint8_t held_count = 0;
+
+static bool stats_dirty = false;
+static uint32_t flush_timer = 0;
+
+/* ==========================================================================
+ * HELPERS
+ * ==========================================================================
+ */
+
+static uint16_t combo_key(const combo_t *combo, uint8_t i) {
+    return pgm_read_word(&combo->keys[i]);
+}
+
+static bool combo_has_key(const combo_t *combo, uint16_t keycode) {
+    for (uint8_t i = 0;; i++) {
+        uint16_t key = combo_key(combo, i);
+        if (key == COMBO_END)
+            return false;
+        if (key == keycode)
+            return true;
+    }
+}
+
+static int8_t held_find(uint16_t keycode) {
+    for (uint8_t i = 0; i < held_count; i++) {
+        if (held[i].keycode == keycode)
+            return i;
+    }
+    return -1;
+}
+
+static void held_remove(uint8_t slot) {
+    held_count--;
+    for (uint8_t i = slot; i < held_count; i++) {
+        held[i] = held[i + 1];
+    }
+}
+
+// FNV-1a over every key of every combo, so reordering or editing
+// combos.def invalidates stats that no longer line up with their combo
+static uint16_t combo_spec_hash(void) {
+    uint16_t count = combo_count();
+    uint32_t hash = 2166136261u;
+
+    for (uint16_t c = 0; c < count; c++) {
+        const combo_t *combo = combo_get(c);
+        for (uint8_t i = 0;; i++) {
+            uint16_t key = combo_key(combo, i);
+            hash = (hash ^ key) * 16777619u;
+            if (key == COMBO_END)
+                break;
+        }
+    }
+    return (uint16_t)(hash ^ (hash >> 16));
+}
+
+/* ==========================================================================
+ * SHARED-KEY GROUPS
+ * ==========================================================================
+ * Union-find over combos: same tier + at least one shared key = same group.
+ * Runs once at boot, so the O(n^2) key comparison doesn't matter.
+ */
+static uint8_t group_root(uint8_t c) {
+    while (group[c] != c) {
+        c = group[c] = group[group[c]];
+    }
+    return c;
+}
+
+static bool combos_share_key(const combo_t *a, const combo_t *b) {
+    for (uint8_t i = 0;; i++) {
+        uint16_t key = combo_key(a, i);
+        if (key == COMBO_END)
+            return false;
+        if (combo_has_key(b, key))
+            return true;
+    }
+}
+
+static void build_groups(void) {
+    uint16_t count = combo_count();
+
+    for (uint8_t c = 0; c < count; c++) {
+        group[c] = c;
+    }
+    for (uint8_t a = 0; a < count; a++) {
+        for (uint8_t b = a + 1; b < count; b++) {
+            if (combo_base_term(a) == combo_base_term(b) &&
+                combos_share_key(combo_get(a), combo_get(b))) {
+                group[group_root(b)] = group_root(a);
+            }
+        }
+    }
+    for (uint8_t c = 0; c < count; c++) {
+        group[c] = group_root(c);
+    }
+}
+
+/* ==========================================================================
+ * LEARNING
+ * ==========================================================================
+ */
+
+static void ema_update(uint16_t *avg, uint16_t *dev, uint8_t *n, uint16_t x) {
+    if (*n == 0) {
+        *avg = x;
+        *dev = x / 4;
+    } else {
+        int16_t diff = (int16_t)(x - *avg);
+        *avg += diff / 8;
+        uint16_t abs_diff = diff < 0 ? -diff : diff;
+        *dev += ((int16_t)(abs_diff - *dev)) / 8;
+    }
+    if (*n < UINT8_MAX)
+        (*n)++;
+}
+
+// Learned term for one combo, ignoring groups (0 = not enough samples)
+static uint16_t learned_term(uint8_t c) {
+    const combo_timing_stats_t *s = &store.stats[c];
+
+    if (s->chord_n < COMBO_TIMING_MIN_SAMPLES)
+        return 0;
+
+    uint16_t upper =
+        ((s->chord_avg + COMBO_TIMING_DEV_MULT * s->chord_dev) >> 4) +
+        COMBO_TIMING_MARGIN;
+    uint16_t term = upper;
+
+    if (s->roll_n >= COMBO_TIMING_MIN_SAMPLES &&
+        s->roll_avg > 2 * s->roll_dev) {
+        uint16_t lower = (s->roll_avg - 2 * s->roll_dev) >> 4;
+        if (lower > upper)
+            term = (upper + lower) / 2;
+    }
+
+    return MAX(term, COMBO_TIMING_MIN_TERM);
+}
+
+// Recompute every published term. Cheap: one pass to find each group's
+// widest term, one pass to hand it out. Members without enough samples of
+// their own count at the tier term, which holds the whole group there.
+static void publish_terms(void) {
+    uint16_t count = combo_count();
+    uint8_t widest[COMBO_TIMING_MAX_COMBOS] = {0};
+
+    for (uint8_t c = 0; c < count; c++) {
+        uint16_t term = learned_term(c);
+        if (term == 0 || term > combo_base_term(c))
+            term = combo_base_term(c);
+        widest[group[c]] = MAX(widest[group[c]], term);
+    }
+    for (uint8_t c = 0; c < count; c++) {
+        terms[c] = widest[group[c]];
+    }
+}
+
+static void take_sample(uint8_t c, uint16_t spread, uint16_t overlap) {
+    combo_timing_stats_t *s = &store.stats[c];
+
+    if (overlap > spread) {
+        ema_update(&s->chord_avg, &s->chord_dev, &s->chord_n, Q4(spread));
+    } else {
+        ema_update(&s->roll_avg, &s->roll_dev, &s->roll_n, Q4(spread));
+    }
+    stats_dirty = true;
+}
+
+// First release of a fully held combo - measure it
+static void sample_combos(uint16_t keycode, keyrecord_t *record) {
+    uint16_t count = combo_count();
+    uint16_t now = record->event.time;
+
+    for (uint8_t c = 0; c < count; c++) {
+        combo_t *combo = combo_get(c);
+
+        if (!combo_has_key(combo, keycode))
+            continue;
+
+        uint16_t first = now, last = 0;
+        bool all_held = true;
+        bool first_key = true;
+        for (uint8_t i = 0; all_held; i++) {
+            uint16_t key = combo_key(combo, i);
+            if (key == COMBO_END)
+                break;
+            int8_t slot = held_find(key);
+            if (slot < 0) {
+                all_held = false;
+                break;
+            }
+            uint16_t t = held[slot].time;
+            // Ages relative to `now` so timer wraparound is harmless
+            if (first_key ||
+                TIMER_DIFF_16(now, t) > TIMER_DIFF_16(now, first))
+                first = t;
+            if (first_key || TIMER_DIFF_16(now, t) < TIMER_DIFF_16(now, last))
+                last = t;
+            first_key = false;
+        }
+        if (!all_held)
+            continue;
+
+        uint16_t spread = TIMER_DIFF_16(last, first);
+        if (spread > COMBO_TIMING_WINDOW)
+            continue;
+
+        // Only learn from layers where this combo is live - holding W+A on
+        // GAMING says nothing about how QW is chorded on BASE
+        if (!combo_should_trigger(c, combo, keycode, record))
+            continue;
+
+        take_sample(c, spread, TIMER_DIFF_16(now, last));
+    }
+
+    if (stats_dirty)
+        publish_terms();
+}
+
+/* ==========================================================================
+ * PUBLIC API
+ * ==========================================================================
+ */
+
+/**
+ * Called from pre_process_record_user() for every raw event, before the
+ * combo engine sees it.
+ */
+void process_combo_timing(keyrecord_t *record) {
+    if (!IS_KEYEVENT(record->event))
+        return;
+
+    // Combos match on BASE keycodes (COMBO_ONLY_FROM_LAYER), so do we
+    uint16_t keycode =
+        keymap_key_to_keycode(COMBO_ONLY_FROM_LAYER, record->event.key);
+    int8_t slot = held_find(keycode);
+
+    if (record->event.pressed) {
+        if (slot >= 0)
+            return;
+        if (held_count == COMBO_TIMING_HELD_MAX)
+            held_remove(0); // drop the oldest, it's long past any window
+        held[held_count].keycode = keycode;
+        held[held_count].time = record->event.time;
+        held_count++;
+    } else if (slot >= 0) {
+        sample_combos(keycode, record);
+        held_remove(slot);
+    }
+}
+
+/**
+ * Term for get_combo_term(). Falls back to the tier term until init has
+ * run and published something.
+ */
+uint16_t combo_timing_term(uint16_t combo_index) {
+    if (combo_index >= COMBO_TIMING_MAX_COMBOS || terms[combo_index] == 0)
+        return combo_base_term(combo_index);
+    return terms[combo_index];
+}
+
+void combo_timing_reset(void) {
+    memset(&store, 0, sizeof(store));
+    store.magic = COMBO_TIMING_MAGIC;
+    store.version = COMBO_TIMING_VERSION;
+    store.count = combo_count();
+    store.spec_hash = combo_spec_hash();
+    eeconfig_update_user_datablock(&store, COMBO_TIMING_EEPROM_OFFSET,
+                                   sizeof(store));
+    stats_dirty = false;
+}
+
+void combo_timing_init(void) {
+    eeconfig_read_user_datablock(&store, COMBO_TIMING_EEPROM_OFFSET,
+                                 sizeof(store));
+
+    if (store.magic != COMBO_TIMING_MAGIC ||
+        store.version != COMBO_TIMING_VERSION ||
+        store.count != combo_count() ||
+        store.spec_hash != combo_spec_hash()) {
+        combo_timing_reset();
+    }
+
+    build_groups();
+    publish_terms();
+    flush_timer = timer_read32();
+}
+
+/**
+ * Periodic EEPROM write-back. Called from housekeeping_task_user().
+ */
+void combo_timing_task(void) {
+    if (!stats_dirty ||
+        timer_elapsed32(flush_timer) < COMBO_TIMING_FLUSH_INTERVAL)
+        return;
+
+    eeconfig_update_user_datablock(&store, COMBO_TIMING_EEPROM_OFFSET,
+                                   sizeof(store));
+    stats_dirty = false;
+    flush_timer = timer_read32();
+}
@@ -0,0 +1,55 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * combo_timing.h - Adaptive combo term (opt-in)
+ *
+ * Enable with COMBO_ADAPTIVE_TERM = yes in rules.mk. See combo_timing.c for
+ * how chords and rolls are told apart and how the term is derived.
+ */
+
+#pragma once
+
+#include "naughtyusername.h"
+
+/* ==========================================================================
+ * TUNABLES
+ * ==========================================================================
+ * All times in ms. Override any of these in config.h.
+ */
+
+// Never narrow below this, no matter how tight the chords are
+#ifndef COMBO_TIMING_MIN_TERM
+#    define COMBO_TIMING_MIN_TERM 10
+#endif
+
+// Chord samples needed before a combo's learned term is used at all
+#ifndef COMBO_TIMING_MIN_SAMPLES
+#    define COMBO_TIMING_MIN_SAMPLES 16
+#endif
+
+// Learned term = chord average + DEV_MULT * chord deviation + MARGIN
+#ifndef COMBO_TIMING_DEV_MULT
+#    define COMBO_TIMING_DEV_MULT 3
+#endif
+#ifndef COMBO_TIMING_MARGIN
+#    define COMBO_TIMING_MARGIN 2
+#endif
+
+// How often learned stats are written back to EEPROM (only if changed)
+#ifndef COMBO_TIMING_FLUSH_INTERVAL
+#    define COMBO_TIMING_FLUSH_INTERVAL 300000
+#endif
+
+/* ==========================================================================
+ * API
+ * ==========================================================================
+ */
+
+// Static tier term for a combo (defined in combos.h from combos.def)
+uint16_t combo_base_term(uint16_t combo_index);
+
+void combo_timing_init(void);
+void combo_timing_reset(void);
+void combo_timing_task(void);
+void process_combo_timing(keyrecord_t *record);
+uint16_t combo_timing_term(uint16_t combo_index);
@@ -7,6 +7,10 @@
  * COMBO_ONLY_FROM_LAYER. Combos trigger based on physical key positions
  * checked against the BASE layer, regardless of what's mapped on the
  * current active layer.
+ *
+ * The combos themselves live in combos.def (one line each). This file turns
+ * that spec into the enum, key arrays, key_combos[] and the lookup tables
+ * the QMK callbacks below use.
  */
 
 #pragma once
@@ -47,299 +51,269 @@
  *  positions (HM_A, HM_F, HM_J, etc.) in key arrays — plain KC_ won't match.
  *
  *  TO ADD A NEW COMBO
- *  1. Add enum entry to combo_names (before COMBO_LENGTH)
- *  2. Add PROGMEM key array (use HM_ for home row mod positions)
- *  3. Add entry to key_combos[] — COMBO() for keycodes, COMBO_ACTION() for
- macros
- *  4. If COMBO_ACTION: add case to process_combo_event()
- *  5. Add timing in get_combo_term() if not MED (default 30ms)
- *  6. Add to get_combo_must_hold() if it needs hold-to-activate (OSM combos)
- *  7. Add layer filter in combo_should_trigger()
+ *  Add one line to combos.def - keys, output, timing tier and layers.
+ *  Everything below is generated from it, there is nothing else to edit.
  *
- *  TIMING TIERS
- *  FAST 18ms — one-shot mods (tight to avoid misfires on common bigrams)
- *  MED  30ms — utility combos (default, most combos use this)
- *  SLOW 50ms — three-finger layer switches (forgiving for 3 keys)
+ *  GENERATED FROM combos.def
+ *    enum combo_names      COMBO_<name> indices
+ *    combo_keys_<name>[]   PROGMEM key arrays (COMBO_END terminated)
+ *    key_combos[]          what QMK introspection looks for
+ *    combo_layers[]        layer mask per combo      → combo_should_trigger
+ *    combo_attrs[]         tier / must-tap / hold    → get_combo_term etc.
+ *    combo_strings[]       SEND_STRING macros        → process_combo_event
  *
- *  COMBO INDEX
- *  ┌────────────────────────┬──────┬────────────┬─────────┬──────────────────┐
- *  │ Enum                   │ Keys │ Output     │ Timing  │ Layers           │
- *  ├────────────────────────┼──────┼────────────┼─────────┼──────────────────┤
- *  │ UTILITY                │      │            │         │                  │
- *  │  COMBO_HJ_CAPSWORD     │ H+J  │ CW_TOGG    │ MED     │ BASE VIM         │
- *  │  COMBO_YH_NUMWORD      │ Y+H  │ NUMWORD    │ MED     │ BASE VIM         │
- *  │  COMBO_JK_ESC          │ J+K  │ KC_ESC     │ MED     │ BASE VIM         │
- *  │  COMBO_LSCLN_ENT       │ L+;  │ KC_ENT     │ MED     │ BASE VIM         │
- *  │  COMBO_FG_TAB          │ F+G  │ KC_TAB     │ MED     │ BASE VIM LOWER   │
- *  │  COMBO_DF_UNDS         │ D+F  │ KC_UNDS    │ MED     │ BASE VIM LOWER   │
- *  │  COMBO_AS_BSPC         │ A+S  │ KC_BSPC    │ MED     │ BASE VIM LOWER   │
- *  │  COMBO_UI_EQUAL         │ U+I  │ KC_EQL     │ FAST    │ BASE LOWER       │
- *  │                        │      │            │         │                  │
- *  │  COMBO_CV_MINS         │ C+V  │ KC_MINS    │ SLOW    │ BASE VIM LOWER   │
- *  │  COMBO_ZX_DEL          │ Z+X  │ KC_DEL     │ SLOW    │ BASE VIM LOWER   │
- *  │  COMBO_DC_ASSEQL       │ D+C  │ :=         │ SLOW    │ BASE VIM LOWER   │
- *  │  COMBO_GB_LEADER       │ G+B  │ QK_LEADER  │ SLOW    │ BASE VIM LOWER   │
- *  │  COMBO_VB_SPC          │ V+B  │ KC_SPC     │ SLOW    │ BASE VIM LOWER   │
- *  │  // XC - Reserved for future use                     │                  │
- *  │                        │      │            │         │                  │
- *  │  COMBO_KL_SQT          │ K+L  │ KC_QUOT    │ MED     │ BASE VIM         │
- *  │  COMBO_JKL_DQT         │ JKL  │ "          │ MED     │ BASE VIM         │
- *  │  COMBO_KL_SCLN_OCSC    │ KL;  │ : ^        │ MED     │ BASE VIM         │
- *  ├────────────────────────┼──────┼────────────┼─────────┼──────────────────┤
- *  │ AUTO-PAIR              │      │            │         │                  │
- *  │  COMBO_NM_PARENS       │ N+M  │ () + ←     │ MED     │ BASE VIM         │
- *  │  COMBO_MCOMM_BRACES    │ M+,  │ {} + ←     │ MED     │ BASE VIM         │
- *  │  COMBO_COMMDOT_BRACKETS│ ,+.  │ [] + ←     │ MED     │ BASE VIM         │
- *  │  COMBO_KCOMM_DQUOTES   │ K+,  │ "" + ←     │ MED     │ BASE VIM         │
- *  │  COMBO_JM_SQUOTES      │ J+M  │ '' + ←     │ MED     │ BASE VIM         │
- *  ├────────────────────────┼──────┼────────────┼─────────┼──────────────────┤
- *  │ ONE-SHOT MODS (GACS)   │      │            │         │                  │
- *  │  COMBO_RT_OSM_LSFT     │ R+T  │ OSM SHIFT  │ FAST    │ BASE VIM         │
- *  │  COMBO_YU_OSM_RSFT     │ Y+U  │ OSM SHIFT  │ FAST    │ BASE VIM         │
- *  │  COMBO_QW_OSM_LGUI     │ Q+W  │ OSM GUI    │ FAST    │ VIM              │
- *  │  COMBO_QW_NEQL         │ Q+W  │ !=         │ FAST    │ BASE             │
- *  │  COMBO_WE_OSM_LALT     │ W+E  │ OSM ALT    │ FAST    │ VIM              │
- *  │  COMBO_ER_OSM_LCTL     │ E+R  │ OSM CTRL   │ FAST    │ VIM              │
- *  │  COMBO_ER_REPEAT       │ E+R  │ QK_REP     │ FAST    │ BASE             │
- *  │  COMBO_UI_OSM_RCTL     │ U+I  │ OSM CTRL   │ FAST    │ VIM              │
- *  │  COMBO_UI_EQUAL         │ U+I  │ KC_EQL     │ FAST    │ BASE LOWER       │
- *  │  COMBO_IO_OSM_RALT     │ I+O  │ OSM ALT    │ FAST    │ VIM              │
- *  │  COMBO_IO_COLON        │ I+O  │ KC_COLN    │ FAST    │ BASE             │
- *  │  COMBO_OP_OSM_RGUI     │ O+P  │ OSM GUI    │ FAST    │ VIM              │
- *  ├────────────────────────┼──────┼────────────┼─────────┼──────────────────┤
- *  │ LAYER SWITCHING        │      │            │         │                  │
- *  │  COMBO_QWE_TO_BASE     │ QWE  │ TO(BASE)   │ SLOW    │ !BASE (anywhere) │
- *  │  COMBO_ASD_TO_GAMING   │ ASD  │ TO(GAMING) │ SLOW    │ BASE             │
- *  │  COMBO_NM_COMM_TO_VIM  │ NM,  │ TO(VIM)    │ SLOW    │ BASE             │
- *  │  COMBO_YUI_TO_GAMING2  │ YUI  │ TO(GAMING2)│ SLOW    │ GAMING           │
- *  │  COMBO_HJK_TO_ROGUELIKE│ HJK  │ TO(ROGUE)  │ SLOW    │ GAMING           │
- *  │  COMBO_YUI_TO_GAMING   │ YUI  │ TO(GAMING) │ SLOW    │ GAMING2          │
- *  │  COMBO_HJK_TO_GAMING   │ HJK  │ TO(GAMING) │ SLOW    │ ROGUELIKE        │
- *  │  COMBO_NM_COMM_TO_BASE │ NM,  │ TO(BASE)   │ SLOW    │ VIM              │
- *  └────────────────────────┴──────┴────────────┴─────────┴──────────────────┘
-    // For personal formatting use, templating etc.
- *  ┌────────────────────────┬──────┬────────────┬─────────┬──────────────────┐
- *  │                        │      │            │         │                  │
- *  ├────────────────────────┼──────┼────────────┼─────────┼──────────────────┤
- *  ├────────────────────────┼──────┼────────────┼─────────┼──────────────────┤
- *  └────────────────────────┴──────┴────────────┴─────────┴──────────────────┘
- *  │                        │      │            │         │                  │
+ *  Every table is indexed by combo, so each callback is one lookup instead
+ *  of a switch over every combo.
  *
- *  OPEN SLOTS (no combo assigned):
- *    2-key:  XC, SD       (left hand)
- *    2-key:  WE, OP  (top row — AVAILABLE ON BASE ONLY)
- *    3-key:  ZXC, ERT, DFG, CVB, IOP, ,./
- *    vert:   QA, WS, ED, RF, TG, HN, UJ, IK, OL, P;, L., ;/
- *    cross:  A;, SL, DK, FJ
+ * ==========================================================================
+ */
+
+/* ==========================================================================
+ * COMBO LAYER MASKS
+ * ==========================================================================
+ * One precomputed layer bitmask per combo. combo_should_trigger() is called
+ * for every candidate combo on every combo key event, so the per-layer
+ * filtering is baked into a PROGMEM table instead of a switch full of
+ * layer_state_is() calls. Eligibility is then a single AND against the
+ * current layer state, no matter how many combos we add.
  *
+ * COMBO_LAYERS_EXCEPT flips the meaning of a mask: the combo fires on every
+ * layer NOT listed (used for the QWE escape hatch).
+ */
+typedef uint16_t combo_layer_mask_t;
+
+#define COMBO_LAYER(layer) ((combo_layer_mask_t)1 << (layer))
+#define COMBO_LAYERS_EXCEPT ((combo_layer_mask_t)1 << 15)
+
+// Bit 15 is the EXCEPT flag, so layers have to stay below it
+_Static_assert(_MOUSE < 15, "combo layer masks only cover layers 0-14");
+
+// Layer groups shared by several combos
+#define CL_BASE_VIM (COMBO_LAYER(_BASE) | COMBO_LAYER(_VIM))
+#define CL_BASE_VIM_LOWER (CL_BASE_VIM | COMBO_LAYER(_LOWER))
+#define CL_GAMING_ALL                                                          \
+    (COMBO_LAYER(_GAMING) | COMBO_LAYER(_GAMING2) | COMBO_LAYER(_ROGUELIKE))
+
+/* ==========================================================================
+ * COMBO ATTRIBUTES
  * ==========================================================================
+ * QMK asks for term / must-hold / must-tap on every overlapping combo key
+ * event. All three are packed into one PROGMEM byte per combo, built at
+ * compile time from combos.def:
+ *
+ *   bits 0-1  timing tier (index into combo_tier_terms[])
+ *   bit  2    must tap  (combo contains a mod-tap or layer-tap key)
+ *   bit  3    must hold (tier written as FAST_HOLD etc.)
  */
-// clang-format off
-enum combo_names {
-    // ===== UTILITY COMBOS (home row) =====
-    COMBO_HJ_CAPSWORD, // H + J = Caps Word
-    COMBO_YH_NUMWORD,  // Y + H        = Num Word (numbers layer lock)
-
-    COMBO_JK_ESC,      // J + K        = Escape
-    COMBO_LSCLN_ENT,   // L + ;        = Enter
-    COMBO_AS_BSPC,     // A + S        = Backspace
-    COMBO_UI_EQUAL,    // U + I        = Equals (BASE/LOWER, shares keys with UI_OSM_RCTL)
-
-    COMBO_KL_SQT,      // K + L        = Single Quote
-    COMBO_FG_TAB,      // F + G        = TAB
-    COMBO_DF_UNDS,     // D + F        = Underscore
-    COMBO_CV_MINS,     // C + V        = Minus
-    COMBO_ZX_DEL,      // Z + X        = Delete
-    COMBO_DC_ASSEQL,   // D + C        = := (assignment operator)
-    COMBO_GB_LEADER,   // G + B        = Leader key start
-    COMBO_VB_SPC,      // V + B        = Space
-
-    // COMBO_SD_MINS,     // C + V        = Minus
-
-    // COMBO_XC_XXX,      // X + C        =
-
-    // Three Finger
-    COMBO_JKL_DQT,     // J + K + L    = Double Quote
-    COMBO_KL_SCLN_OCSC,// K + L + ;    = : ^ colon space caret combo - very
-                       // useful in odin
-
-    // ===== AUTO-PAIR COMBOS (bottom row) =====
-    COMBO_NM_PARENS,        // N + M = () with cursor inside
-    COMBO_MCOMM_BRACES,     // M + , = {} with cursor inside
-    COMBO_COMMDOT_BRACKETS, // , + . = [] with cursor inside
-    COMBO_KCOMM_DQUOTES,    // K + , = "" with cursor inside
-    COMBO_JM_SQUOTES,       // J + M = '' with cursor inside
-
-    // ===== TOP ROW UTILITY COMBOS (BASE only, shares keys with VIM OSM combos) =====
-    COMBO_QW_NEQL,     // Q + W        = != (not equal)
-    COMBO_ER_REPEAT,   // E + R        = Repeat Key
-    COMBO_IO_COLON,    // I + O        = Colon
-
-    // ===== ONE-SHOT MODIFIER COMBOS (top row, GACS order) =====
-    // Left hand
-    COMBO_QW_OSM_LGUI, // Q + W = One-shot GUI
-    COMBO_WE_OSM_LALT, // W + E = One-shot Alt
-    COMBO_ER_OSM_LCTL, // E + R = One-shot Ctrl
-    COMBO_RT_OSM_LSFT, // R + T = One-shot Shift
-    // Right hand
-    COMBO_YU_OSM_RSFT, // Y + U = One-shot Shift
-    COMBO_UI_OSM_RCTL, // U + I = One-shot Ctrl
-    COMBO_IO_OSM_RALT, // I + O = One-shot Alt
-    COMBO_OP_OSM_RGUI, // O + P = One-shot GUI
-
-    // ===== LAYER SWITCHING COMBOS =====
-    // Universal escape hatch
-    COMBO_QWE_TO_BASE, // Q + W + E = Return to BASE (from anywhere)
-
-    // From BASE
-    COMBO_ASD_TO_GAMING,  // A + S + D = Go to GAMING
-    COMBO_NM_COMM_TO_VIM, // N + M + , = Go to VIM
-
-    // From GAMING
-    COMBO_YUI_TO_GAMING2,   // Y + U + I = Go to GAMING2
-    COMBO_HJK_TO_ROGUELIKE, // H + J + K = Go to ROGUELIKE
-
-    // Return routes (same combos, opposite direction)
-    COMBO_YUI_TO_GAMING,   // Y + U + I = Return to GAMING (from GAMING2)
-    COMBO_HJK_TO_GAMING,   // H + J + K = Return to GAMING (from ROGUELIKE)
-    COMBO_NM_COMM_TO_BASE, // N + M + , = Return to BASE (from VIM)
+enum combo_tier {
+    COMBO_TIER_MED = 0,
+    COMBO_TIER_FAST,
+    COMBO_TIER_SLOW,
+};
+
+#define COMBO_ATTR_TIER_MASK 0x03
+#define COMBO_ATTR_MUST_TAP (1 << 2)
+#define COMBO_ATTR_MUST_HOLD (1 << 3)
+
+// Tier names as written in combos.def
+#define COMBO_ATTR_FAST COMBO_TIER_FAST
+#define COMBO_ATTR_MED COMBO_TIER_MED
+#define COMBO_ATTR_SLOW COMBO_TIER_SLOW
+#define COMBO_ATTR_FAST_HOLD (COMBO_TIER_FAST | COMBO_ATTR_MUST_HOLD)
+#define COMBO_ATTR_MED_HOLD (COMBO_TIER_MED | COMBO_ATTR_MUST_HOLD)
+#define COMBO_ATTR_SLOW_HOLD (COMBO_TIER_SLOW | COMBO_ATTR_MUST_HOLD)
+
+#ifdef COMBO_ADAPTIVE_TERM
+#    include "combo_timing.h"
+#endif
+#ifdef COMBO_STATS
+#    include "combo_stats.h"
+#endif
+#ifdef COMBO_EARLY_FIRE
+#    include "combo_early.h"
+#endif
+
+static const uint8_t combo_tier_terms[] = {
+    [COMBO_TIER_MED] = COMBO_MED,
+    [COMBO_TIER_FAST] = COMBO_FAST,
+    [COMBO_TIER_SLOW] = COMBO_SLOW,
+};
 
+// Must-tap detection as a constant expression, so it can go in the table.
+// Covers up to 4 keys per combo (checked by a static assert below).
+#define COMBO_KEY_IS_HOLD_TAP(k)                                               \
+    (((k) >= QK_MOD_TAP && (k) <= QK_MOD_TAP_MAX) ||                           \
+     ((k) >= QK_LAYER_TAP && (k) <= QK_LAYER_TAP_MAX))
+#define COMBO_ANY_HOLD_TAP_(a, b, c, d, ...)                                   \
+    (COMBO_KEY_IS_HOLD_TAP(a) || COMBO_KEY_IS_HOLD_TAP(b) ||                   \
+     COMBO_KEY_IS_HOLD_TAP(c) || COMBO_KEY_IS_HOLD_TAP(d))
+#define COMBO_ANY_HOLD_TAP(...)                                                \
+    COMBO_ANY_HOLD_TAP_(__VA_ARGS__, KC_NO, KC_NO, KC_NO)
+#define COMBO_MAX_KEYS 4
+
+/* ==========================================================================
+ * GENERATED: COMBO ENUM
+ * ==========================================================================
+ */
+#define COMB(name, keycode, tier, layers, ...) COMBO_##name,
+#define SUBS(name, string, tier, layers, ...) COMBO_##name,
+#define SUBS_THEN(name, string, keycode, tier, layers, ...) COMBO_##name,
+enum combo_names {
+#include "combos.def"
     // Total count - MUST be last
     COMBO_LENGTH
 };
+#undef COMB
+#undef SUBS
+#undef SUBS_THEN
+
+#ifdef COMBO_ADAPTIVE_TERM
+_Static_assert(COMBO_LENGTH <= COMBO_TIMING_MAX_COMBOS,
+               "raise COMBO_TIMING_MAX_COMBOS in config.h");
+#endif
+#ifdef COMBO_STATS
+_Static_assert(COMBO_LENGTH <= COMBO_STATS_MAX_COMBOS,
+               "raise COMBO_STATS_MAX_COMBOS in config.h");
+#endif
 
 /* ==========================================================================
- * COMBO KEY ARRAYS
+ * GENERATED: COMBO KEY ARRAYS
  * ==========================================================================
  * All arrays use BASE layer keycodes (including home row mods).
  * COMBO_ONLY_FROM_LAYER makes these work on any layer by checking
  * physical positions against BASE.
- *
- * Requirements:
- *   - const uint16_t PROGMEM
- *   - End with COMBO_END
  */
-
-// ----- Utility Combos -----
-const uint16_t PROGMEM combo_hj[] = {KC_H, HM_J, COMBO_END};
-const uint16_t PROGMEM combo_jk[] = {HM_J, HM_K, COMBO_END};
-const uint16_t PROGMEM combo_lscln[] = {HM_L, HM_SCLN, COMBO_END};
-const uint16_t PROGMEM combo_df[] = {HM_D, HM_F, COMBO_END};
-const uint16_t PROGMEM combo_cv[] = {KC_C, KC_V, COMBO_END};
-const uint16_t PROGMEM combo_zx[] = {LT(_SYS, KC_Z), KC_X, COMBO_END};
-const uint16_t PROGMEM combo_dc[] = {HM_D, KC_C, COMBO_END};
-const uint16_t PROGMEM combo_gb[] = {KC_G, KC_B, COMBO_END};
-const uint16_t PROGMEM combo_vb[] = {KC_V, KC_B, COMBO_END};
-const uint16_t PROGMEM combo_fg[] = {HM_F, KC_G, COMBO_END};
-const uint16_t PROGMEM combo_as[] = {HM_A, HM_S, COMBO_END};
-
-
-const uint16_t PROGMEM combo_kl[] = {HM_K, HM_L, COMBO_END};
-const uint16_t PROGMEM combo_yh[] = {KC_Y, KC_H, COMBO_END};
-
-// ----- Three Finger Utility Combos
-const uint16_t PROGMEM combo_jkl[] = {HM_J, HM_K, HM_L, COMBO_END};
-const uint16_t PROGMEM combo_kl_scln[] = {HM_K, HM_L, HM_SCLN, COMBO_END};
-
-// ----- Auto-Pair Combos -----
-const uint16_t PROGMEM combo_nm[] = {KC_N, KC_M, COMBO_END};
-const uint16_t PROGMEM combo_mcomm[] = {KC_M, KC_COMM, COMBO_END};
-const uint16_t PROGMEM combo_commdot[] = {KC_COMM, KC_DOT, COMBO_END};
-const uint16_t PROGMEM combo_kcomm[] = {HM_K, KC_COMM, COMBO_END};
-const uint16_t PROGMEM combo_jm[] = {HM_J, KC_M, COMBO_END};
-
-// ----- One-Shot Mod Combos -----
-// Left hand (GACS: GUI, Alt, Ctrl, Shift from pinky to index)
-const uint16_t PROGMEM combo_qw[] = {KC_Q, KC_W, COMBO_END};
-const uint16_t PROGMEM combo_we[] = {KC_W, KC_E, COMBO_END};
-const uint16_t PROGMEM combo_er[] = {KC_E, KC_R, COMBO_END};
-const uint16_t PROGMEM combo_rt[] = {KC_R, KC_T, COMBO_END};
-// Right hand (GACS: Shift, Ctrl, Alt, GUI from index to pinky)
-const uint16_t PROGMEM combo_yu[] = {KC_Y, KC_U, COMBO_END};
-const uint16_t PROGMEM combo_ui[] = {KC_U, KC_I, COMBO_END};
-const uint16_t PROGMEM combo_io[] = {KC_I, KC_O, COMBO_END};
-const uint16_t PROGMEM combo_op[] = {KC_O, KC_P, COMBO_END};
-
-// ----- Layer Switching Combos -----
-const uint16_t PROGMEM combo_qwe[] = {KC_Q, KC_W, KC_E, COMBO_END};
-const uint16_t PROGMEM combo_asd[] = {HM_A, HM_S, HM_D, COMBO_END};
-const uint16_t PROGMEM combo_yui[] = {KC_Y, KC_U, KC_I, COMBO_END};
-const uint16_t PROGMEM combo_hjk[] = {KC_H, HM_J, HM_K, COMBO_END};
-const uint16_t PROGMEM combo_nm_comm[] = {KC_N, KC_M, KC_COMM, COMBO_END};
+#define COMBO_KEYS_(name, ...)                                                 \
+    const uint16_t PROGMEM combo_keys_##name[] = {__VA_ARGS__, COMBO_END};     \
+    _Static_assert(sizeof(combo_keys_##name) / sizeof(uint16_t) - 1 <=         \
+                       COMBO_MAX_KEYS,                                         \
+                   "combo " #name " has more than COMBO_MAX_KEYS keys");
+#define COMB(name, keycode, tier, layers, ...) COMBO_KEYS_(name, __VA_ARGS__)
+#define SUBS(name, string, tier, layers, ...) COMBO_KEYS_(name, __VA_ARGS__)
+#define SUBS_THEN(name, string, keycode, tier, layers, ...)                    \
+    COMBO_KEYS_(name, __VA_ARGS__)
+#include "combos.def"
+#undef COMB
+#undef SUBS
+#undef SUBS_THEN
 
 /* ==========================================================================
- * COMBO DEFINITIONS ARRAY
+ * GENERATED: COMBO DEFINITIONS ARRAY
  * ==========================================================================
  * This MUST be named `key_combos` - QMK looks for this specific name.
+ * SUBS combos are COMBO_ACTIONs, handled in process_combo_event().
  *
  * Note: Some combos share the same keys but have different layer filters
- * (handled in combo_should_trigger). For example:
+ * (handled by combo_layers[] / combo_should_trigger). For example:
  *   - COMBO_YUI_TO_GAMING2: fires on GAMING layer
  *   - COMBO_YUI_TO_GAMING: fires on GAMING2 layer
  */
+#define COMB(name, keycode, tier, layers, ...)                                 \
+    [COMBO_##name] = COMBO(combo_keys_##name, keycode),
+#define SUBS(name, string, tier, layers, ...)                                  \
+    [COMBO_##name] = COMBO_ACTION(combo_keys_##name),
+#define SUBS_THEN(name, string, keycode, tier, layers, ...)                    \
+    [COMBO_##name] = COMBO_ACTION(combo_keys_##name),
 combo_t key_combos[COMBO_LENGTH] = {
-    // ===== UTILITY COMBOS =====
-    [COMBO_HJ_CAPSWORD] = COMBO(combo_hj, CW_TOGG),
-    [COMBO_YH_NUMWORD] = COMBO(combo_yh, NUMWORD),
-    [COMBO_JK_ESC] = COMBO(combo_jk, KC_ESC),
-    [COMBO_LSCLN_ENT] = COMBO(combo_lscln, KC_ENT),
-    [COMBO_DF_UNDS] = COMBO(combo_df, KC_UNDS),
-    [COMBO_FG_TAB] = COMBO(combo_fg, KC_TAB),
-    [COMBO_AS_BSPC] = COMBO(combo_as, KC_BSPC),
-    [COMBO_UI_EQUAL] = COMBO(combo_ui, KC_EQL),
-    [COMBO_CV_MINS] = COMBO(combo_cv, KC_MINS),
-    [COMBO_ZX_DEL] = COMBO(combo_zx, KC_DEL),
-    [COMBO_DC_ASSEQL] = COMBO(combo_dc, KC_ASSIGN),
-    [COMBO_VB_SPC] = COMBO(combo_vb, KC_SPC),
-#ifdef LEADER_ENABLE
-    [COMBO_GB_LEADER] = COMBO(combo_gb, QK_LEADER),
-#endif
-    [COMBO_KL_SQT] = COMBO(combo_kl, KC_QUOT),
-
-    [COMBO_JKL_DQT] = COMBO_ACTION(combo_jkl),
-    [COMBO_KL_SCLN_OCSC] = COMBO_ACTION(combo_kl_scln),
-
-    // ===== AUTO-PAIR COMBOS (use COMBO_ACTION for macros) =====
-    [COMBO_NM_PARENS] = COMBO_ACTION(combo_nm),
-    [COMBO_MCOMM_BRACES] = COMBO_ACTION(combo_mcomm),
-    [COMBO_COMMDOT_BRACKETS] = COMBO_ACTION(combo_commdot),
-    [COMBO_KCOMM_DQUOTES] = COMBO_ACTION(combo_kcomm),
-    [COMBO_JM_SQUOTES] = COMBO_ACTION(combo_jm),
-
-    // ===== TOP ROW UTILITY COMBOS (BASE only) =====
-    [COMBO_QW_NEQL] = COMBO_ACTION(combo_qw),
-    [COMBO_ER_REPEAT] = COMBO(combo_er, QK_REP),
-    [COMBO_IO_COLON] = COMBO(combo_io, KC_COLN),
-
-    // ===== ONE-SHOT MODIFIER COMBOS =====
-    // Left hand
-    [COMBO_QW_OSM_LGUI] = COMBO(combo_qw, OSM(MOD_LGUI)),
-    [COMBO_WE_OSM_LALT] = COMBO(combo_we, OSM(MOD_LALT)),
-    [COMBO_ER_OSM_LCTL] = COMBO(combo_er, OSM(MOD_LCTL)),
-    [COMBO_RT_OSM_LSFT] = COMBO(combo_rt, OSM(MOD_LSFT)),
-    // Right hand
-    [COMBO_YU_OSM_RSFT] = COMBO(combo_yu, OSM(MOD_RSFT)),
-    [COMBO_UI_OSM_RCTL] = COMBO(combo_ui, OSM(MOD_RCTL)),
-    [COMBO_IO_OSM_RALT] = COMBO(combo_io, OSM(MOD_RALT)),
-    [COMBO_OP_OSM_RGUI] = COMBO(combo_op, OSM(MOD_RGUI)),
-
-    // ===== LAYER SWITCHING COMBOS =====
-    // Universal escape - QWE always returns to BASE
-    [COMBO_QWE_TO_BASE] = COMBO(combo_qwe, TO(_BASE)),
-
-    // From BASE - outbound routes
-    [COMBO_ASD_TO_GAMING] = COMBO(combo_asd, TO(_GAMING)),
-    [COMBO_NM_COMM_TO_VIM] = COMBO(combo_nm_comm, TO(_VIM)),
-
-    // From GAMING - outbound routes
-    [COMBO_YUI_TO_GAMING2] = COMBO(combo_yui, TO(_GAMING2)),
-    [COMBO_HJK_TO_ROGUELIKE] = COMBO(combo_hjk, TO(_ROGUELIKE)),
-
-    // Return routes - same keys, different source layers
-    [COMBO_YUI_TO_GAMING] = COMBO(combo_yui, TO(_GAMING)),
-    [COMBO_HJK_TO_GAMING] = COMBO(combo_hjk, TO(_GAMING)),
-    [COMBO_NM_COMM_TO_BASE] = COMBO(combo_nm_comm, TO(_BASE)),
+#include "combos.def"
 };
+#undef COMB
+#undef SUBS
+#undef SUBS_THEN
+
+/* ==========================================================================
+ * GENERATED: PER-COMBO TABLES
+ * ==========================================================================
+ */
+#define COMB(name, keycode, tier, layers, ...) [COMBO_##name] = (layers),
+#define SUBS(name, string, tier, layers, ...) [COMBO_##name] = (layers),
+#define SUBS_THEN(name, string, keycode, tier, layers, ...)                    \
+    [COMBO_##name] = (layers),
+static const combo_layer_mask_t PROGMEM combo_layers[COMBO_LENGTH] = {
+#include "combos.def"
+};
+#undef COMB
+#undef SUBS
+#undef SUBS_THEN
+
+#define COMBO_ATTRS_(tier, ...)                                                \
+    (COMBO_ATTR_##tier |                                                       \
+     (COMBO_ANY_HOLD_TAP(__VA_ARGS__) ? COMBO_ATTR_MUST_TAP : 0))
+#define COMB(name, keycode, tier, layers, ...)                                 \
+    [COMBO_##name] = COMBO_ATTRS_(tier, __VA_ARGS__),
+#define SUBS(name, string, tier, layers, ...)                                  \
+    [COMBO_##name] = COMBO_ATTRS_(tier, __VA_ARGS__),
+#define SUBS_THEN(name, string, keycode, tier, layers, ...)                    \
+    [COMBO_##name] = COMBO_ATTRS_(tier, __VA_ARGS__),
+static const uint8_t PROGMEM combo_attrs[COMBO_LENGTH] = {
+#include "combos.def"
+};
+#undef COMB
+#undef SUBS
+#undef SUBS_THEN
+
+// Macro strings - one PROGMEM string per SUBS combo, then a pointer table.
+// combo_then[] holds the optional keycode tapped after the string.
+#define COMB(name, keycode, tier, layers, ...)
+#define SUBS(name, string, tier, layers, ...)                                  \
+    static const char PROGMEM combo_str_##name[] = string;
+#define SUBS_THEN(name, string, keycode, tier, layers, ...)                    \
+    static const char PROGMEM combo_str_##name[] = string;
+#include "combos.def"
+#undef SUBS
+#undef SUBS_THEN
+
+#define SUBS(name, string, tier, layers, ...)                                  \
+    [COMBO_##name] = combo_str_##name,
+#define SUBS_THEN(name, string, keycode, tier, layers, ...)                    \
+    [COMBO_##name] = combo_str_##name,
+static const char *const PROGMEM combo_strings[COMBO_LENGTH] = {
+#include "combos.def"
+};
+#undef SUBS
+
+#define SUBS(name, string, tier, layers, ...)
+#undef SUBS_THEN
+#define SUBS_THEN(name, string, keycode, tier, layers, ...)                    \
+    [COMBO_##name] = (keycode),
+static const uint16_t PROGMEM combo_then[COMBO_LENGTH] = {
+#include "combos.def"
+};
+#undef COMB
+#undef SUBS
+#undef SUBS_THEN
+
+#ifdef COMBO_STATS
+// Combo names for the raw HID stats dump, so the host tool doesn't have to
+// parse combos.def (and guess which #ifdefs were on)
+#    define COMB(name, keycode, tier, layers, ...)                             \
+        static const char PROGMEM combo_name_##name[] = #name;
+#    define SUBS(name, string, tier, layers, ...)                              \
+        static const char PROGMEM combo_name_##name[] = #name;
+#    define SUBS_THEN(name, string, keycode, tier, layers, ...)                \
+        static const char PROGMEM combo_name_##name[] = #name;
+#    include "combos.def"
+#    undef COMB
+#    undef SUBS
+#    undef SUBS_THEN
+
+#    define COMB(name, keycode, tier, layers, ...)                             \
+        [COMBO_##name] = combo_name_##name,
+#    define SUBS(name, string, tier, layers, ...)                              \
+        [COMBO_##name] = combo_name_##name,
+#    define SUBS_THEN(name, string, keycode, tier, layers, ...)                \
+        [COMBO_##name] = combo_name_##name,
+static const char *const PROGMEM combo_name_strings[COMBO_LENGTH] = {
+#    include "combos.def"
+};
+#    undef COMB
+#    undef SUBS
+#    undef SUBS_THEN
+
+const char *combo_name(uint16_t combo_index) {
+    return (const char *)pgm_read_ptr(&combo_name_strings[combo_index]);
+}
+#endif
 
 /* ==========================================================================
  * COMBO CALLBACKS
@@ -347,120 +321,62 @@ combo_t key_combos[COMBO_LENGTH] = {
  */
 
 /**
- * Process custom combo actions (COMBO_ACTION entries)
+ * Process custom combo actions (SUBS entries in combos.def)
  * Used for auto-pairing brackets/quotes with cursor positioning
+ *
+ * QMK calls this for every combo that fires, not just COMBO_ACTIONs, which
+ * is also what makes it the "fired" counter for COMBO_STATS.
  */
 void process_combo_event(uint16_t combo_index, bool pressed) {
     if (!pressed)
         return; // Only act on key press, not release
 
-    switch (combo_index) {
-    case COMBO_NM_PARENS:
-        // Type () and move cursor inside
-        SEND_STRING("()" SS_TAP(X_LEFT));
-        break;
-    case COMBO_MCOMM_BRACES:
-        // Type {} and move cursor inside
-        SEND_STRING("{}" SS_TAP(X_LEFT));
-        break;
-    case COMBO_COMMDOT_BRACKETS:
-        // Type [] and move cursor inside
-        SEND_STRING("[]" SS_TAP(X_LEFT));
-        break;
-    case COMBO_KCOMM_DQUOTES:
-        // Type "" and move cursor inside
-        SEND_STRING("\"\"" SS_TAP(X_LEFT));
-        break;
-    case COMBO_JKL_DQT:
-        // Type "
-        SEND_STRING("\"");
-        break;
-    case COMBO_KL_SCLN_OCSC:
-        // Type ": ^" then one-shot shift (activates for next key, auto-releases)
-        SEND_STRING(": ^");
-        tap_code16(OSM(MOD_LSFT));
-        break;
-    case COMBO_JM_SQUOTES:
-        // Type '' and move cursor inside
-        SEND_STRING("''" SS_TAP(X_LEFT));
-        break;
-    case COMBO_QW_NEQL:
-        SEND_STRING("!=");
-        break;
+#ifdef COMBO_STATS
+    combo_stats_fired(combo_index);
+#endif
+
+    const char *str = (const char *)pgm_read_ptr(&combo_strings[combo_index]);
+    if (!str)
+        return;
+
+    send_string_P(str);
+
+    uint16_t then = pgm_read_word(&combo_then[combo_index]);
+    if (then) {
+        // e.g. one-shot shift (activates for next key, auto-releases)
+        tap_code16(then);
     }
 }
 
 /**
  * Per-combo timing control
  * Matches ZMK timing tiers: FAST (18ms), MED (30ms), SLOW (50ms)
+ *
+ * With COMBO_ADAPTIVE_TERM the tier is an upper bound and combo_timing.c
+ * narrows it from observed chords.
  */
+uint16_t combo_base_term(uint16_t combo_index) {
+    uint8_t attrs = pgm_read_byte(&combo_attrs[combo_index]);
+    return combo_tier_terms[attrs & COMBO_ATTR_TIER_MASK];
+}
+
 uint16_t get_combo_term(uint16_t combo_index, combo_t *combo) {
-    switch (combo_index) {
-    // One-shot mods need very tight timing to prevent misfires
-    // during normal typing (we, er, etc. are common bigrams)
-    // Top row combos must all share COMBO_FAST timing — combos on the same
-    // physical keys need identical timing or the rejected combo's early
-    // resolution can swallow keypresses before the other combo's window fires.
-    case COMBO_QW_OSM_LGUI:
-    case COMBO_QW_NEQL:
-    case COMBO_WE_OSM_LALT:
-    case COMBO_ER_OSM_LCTL:
-    case COMBO_ER_REPEAT:
-    case COMBO_RT_OSM_LSFT:
-    case COMBO_YU_OSM_RSFT:
-    case COMBO_UI_OSM_RCTL:
-    case COMBO_UI_EQUAL:
-    case COMBO_IO_OSM_RALT:
-    case COMBO_IO_COLON:
-    case COMBO_OP_OSM_RGUI:
-        return COMBO_FAST; // 18ms
-
-    // Three-finger layer switches need more time
-    // Bottom row combos get forgiving timing too
-    case COMBO_QWE_TO_BASE:
-    case COMBO_ASD_TO_GAMING:
-    case COMBO_YUI_TO_GAMING2:
-    case COMBO_YUI_TO_GAMING:
-    case COMBO_HJK_TO_ROGUELIKE:
-    case COMBO_HJK_TO_GAMING:
-    case COMBO_NM_COMM_TO_VIM:
-    case COMBO_NM_COMM_TO_BASE:
-    case COMBO_ZX_DEL:
-    case COMBO_CV_MINS:
-    case COMBO_DC_ASSEQL:
-    case COMBO_GB_LEADER:
-    case COMBO_VB_SPC:
-        return COMBO_SLOW; // 50ms
-
-    // Everything else uses medium timing
-    default:
-        return COMBO_MED; // 30ms
-    }
+#ifdef COMBO_ADAPTIVE_TERM
+    return combo_timing_term(combo_index);
+#else
+    return combo_base_term(combo_index);
+#endif
 }
 
 /**
- * Must-hold requirement for one-shot mod combos
- * Prevents accidental OSM activation during fast typing
+ * Must-hold requirement (tier written as *_HOLD in combos.def)
  *
  * Behavior:
  *   - Tap Q+W quickly → normal QW output (no combo)
- *   - Hold Q+W → one-shot GUI activates
+ *   - Hold Q+W → combo activates
  */
 bool get_combo_must_hold(uint16_t combo_index, combo_t *combo) {
-    switch (combo_index) {
-    // All top row OSM combos fire on tap, no hold required
-    case COMBO_QW_OSM_LGUI:
-    case COMBO_WE_OSM_LALT:
-    case COMBO_ER_OSM_LCTL:
-    case COMBO_RT_OSM_LSFT:
-    case COMBO_YU_OSM_RSFT:
-    case COMBO_UI_OSM_RCTL:
-    case COMBO_IO_OSM_RALT:
-    case COMBO_OP_OSM_RGUI:
-        return false;
-    default:
-        return false;
-    }
+    return pgm_read_byte(&combo_attrs[combo_index]) & COMBO_ATTR_MUST_HOLD;
 }
 
 /**
@@ -472,18 +388,20 @@ bool get_combo_must_hold(uint16_t combo_index, combo_t *combo) {
  *   - Hold J+K → Shift+Ctrl activates (no combo, mods work)
  */
 bool get_combo_must_tap(uint16_t combo_index, combo_t *combo) {
-    // Check if any key in the combo is a mod-tap
-    uint16_t key;
-    uint8_t idx = 0;
-    while ((key = pgm_read_word(&combo->keys[idx])) != COMBO_END) {
-        switch (key) {
-        case QK_MOD_TAP ... QK_MOD_TAP_MAX:
-        case QK_LAYER_TAP ... QK_LAYER_TAP_MAX:
-            return true;
-        }
-        idx += 1;
-    }
-    return false;
+    return pgm_read_byte(&combo_attrs[combo_index]) & COMBO_ATTR_MUST_TAP;
+}
+
+/**
+ * Does a layer mask from combo_layers[] include the current layer state?
+ *
+ * layer_state == 0 means only BASE is active (same rule layer_state_is()
+ * uses), so it is treated as the BASE bit.
+ */
+static bool combo_mask_active(combo_layer_mask_t mask) {
+    layer_state_t state = layer_state ? layer_state : COMBO_LAYER(_BASE);
+    bool on_layer = (state & mask) != 0;
+
+    return on_layer != ((mask & COMBO_LAYERS_EXCEPT) != 0);
 }
 
 /**
@@ -495,99 +413,83 @@ bool get_combo_must_tap(uint16_t combo_index, combo_t *combo) {
  */
 bool combo_should_trigger(uint16_t combo_index, combo_t *combo,
                           uint16_t keycode, keyrecord_t *record) {
-    switch (combo_index) {
-    // ===== UNIVERSAL ESCAPE HATCH =====
-    // QWE returns to BASE from anywhere EXCEPT base itself
-    case COMBO_QWE_TO_BASE:
-        return !layer_state_is(_BASE);
-
-    // ===== FROM BASE =====
-    case COMBO_ASD_TO_GAMING:
-    case COMBO_NM_COMM_TO_VIM:
-        return layer_state_is(_BASE);
-
-    // ===== FROM GAMING =====
-    case COMBO_YUI_TO_GAMING2:
-    case COMBO_HJK_TO_ROGUELIKE:
-        return layer_state_is(_GAMING);
-
-    // ===== RETURN ROUTES =====
-    // YUI returns to GAMING only from GAMING2
-    case COMBO_YUI_TO_GAMING:
-        return layer_state_is(_GAMING2);
-
-    // HJK returns to GAMING only from ROGUELIKE
-    case COMBO_HJK_TO_GAMING:
-        return layer_state_is(_ROGUELIKE);
-
-    // NM, returns to BASE only from VIM
-    case COMBO_NM_COMM_TO_BASE:
-        return layer_state_is(_VIM);
-
-    // ===== UTILITY COMBOS (LEFT HAND + BOTTOM ROW) =====
-    // These work on BASE, VIM, and LOWER (useful while holding LOWER with right hand)
-    case COMBO_DF_UNDS:
-    case COMBO_FG_TAB:
-    case COMBO_AS_BSPC:
-    case COMBO_CV_MINS:
-    case COMBO_ZX_DEL:
-    case COMBO_DC_ASSEQL:
-    case COMBO_GB_LEADER:
-    case COMBO_VB_SPC:
-        return layer_state_is(_BASE) || layer_state_is(_VIM) || layer_state_is(_LOWER);
-
-    // ===== UTILITY & AUTO-PAIR COMBOS =====
-    // These work on BASE and VIM only
-    case COMBO_HJ_CAPSWORD:
-    case COMBO_JK_ESC:
-    case COMBO_LSCLN_ENT:
-    case COMBO_KL_SQT:
-    case COMBO_NM_PARENS:
-    case COMBO_MCOMM_BRACES:
-    case COMBO_COMMDOT_BRACKETS:
-    case COMBO_KCOMM_DQUOTES:
-    case COMBO_JM_SQUOTES:
-    case COMBO_YH_NUMWORD:
-    case COMBO_JKL_DQT:
-    case COMBO_KL_SCLN_OCSC:
-        return layer_state_is(_BASE) || layer_state_is(_VIM);
-
-    // ===== ONE-SHOT MOD COMBOS =====
-    // Shift combos: BASE, VIM, and all gaming layers
-    case COMBO_RT_OSM_LSFT:
-    case COMBO_YU_OSM_RSFT:
-        return layer_state_is(_BASE) || layer_state_is(_VIM) ||
-               layer_state_is(_GAMING) || layer_state_is(_GAMING2) || layer_state_is(_ROGUELIKE);
-
-    // GUI/ALT left-hand: VIM only (BASE top row used for utility combos)
-    case COMBO_QW_OSM_LGUI:
-    case COMBO_WE_OSM_LALT:
-        return layer_state_is(_VIM);
-
-    // CTRL/ALT/GUI: VIM + all gaming layers
-    case COMBO_ER_OSM_LCTL:
-    case COMBO_UI_OSM_RCTL:
-    case COMBO_IO_OSM_RALT:
-    case COMBO_OP_OSM_RGUI:
-        return layer_state_is(_VIM) ||
-               layer_state_is(_GAMING) || layer_state_is(_GAMING2) || layer_state_is(_ROGUELIKE);
-
-    // ===== TOP ROW UTILITY COMBOS (BASE only, paired with VIM OSM combos above) =====
-    case COMBO_QW_NEQL:
-    case COMBO_ER_REPEAT:
-    case COMBO_IO_COLON:
-        return layer_state_is(_BASE);
-
-    // ===== EQUALS COMBO (BASE + LOWER) =====
-    case COMBO_UI_EQUAL:
-        return layer_state_is(_BASE) || layer_state_is(_LOWER);
-
-    // Default: allow combo
-    default:
-        return true;
+    return combo_mask_active(pgm_read_word(&combo_layers[combo_index]));
+}
+
+#ifdef COMBO_EARLY_FIRE
+/* ==========================================================================
+ * SUPERSET GRAPH
+ * ==========================================================================
+ * A combo is "terminal" on a layer when no other combo using all of its
+ * keys is live there, e.g. NM on BASE is NOT terminal (NM_COMM_TO_VIM could
+ * still follow), but CV on BASE is. A terminal combo is fully resolved the
+ * moment its keys are down - there is nothing left to wait for, and
+ * combo_early.c fires it right away.
+ *
+ * Combos on exactly the same keys count as supersets too: UI_EQUAL and
+ * UI_OSM_RCTL on one layer would need the wait to tell them apart.
+ *
+ * For each combo we OR together the layer masks of all its supersets, so
+ * the check is a single AND against layer_state. Built on first use since
+ * set inclusion can't be done in the preprocessor; the O(n^2) walk happens
+ * once.
+ */
+#    define COMBO_ALL_LAYERS ((combo_layer_mask_t)(COMBO_LAYERS_EXCEPT - 1))
+
+static combo_layer_mask_t combo_superset_layers[COMBO_LENGTH];
+static bool combo_supersets_ready = false;
+
+// EXCEPT masks are inverted to plain masks so supersets can be OR'd
+static combo_layer_mask_t combo_plain_mask(uint16_t combo_index) {
+    combo_layer_mask_t mask = pgm_read_word(&combo_layers[combo_index]);
+    if (mask & COMBO_LAYERS_EXCEPT)
+        return ~mask & COMBO_ALL_LAYERS;
+    return mask;
+}
+
+// Every key of `sub` is also in `super`
+static bool combo_keys_subset(uint16_t sub, uint16_t super) {
+    const uint16_t *sub_keys = key_combos[sub].keys;
+    const uint16_t *super_keys = key_combos[super].keys;
+
+    for (uint8_t i = 0;; i++) {
+        uint16_t key = pgm_read_word(&sub_keys[i]);
+        if (key == COMBO_END)
+            return true;
+        bool found = false;
+        for (uint8_t j = 0; !found; j++) {
+            uint16_t other = pgm_read_word(&super_keys[j]);
+            if (other == COMBO_END)
+                return false;
+            found = other == key;
+        }
     }
 }
 
+static void build_combo_supersets(void) {
+    for (uint16_t a = 0; a < COMBO_LENGTH; a++) {
+        combo_superset_layers[a] = 0;
+
+        for (uint16_t b = 0; b < COMBO_LENGTH; b++) {
+            if (b != a && combo_keys_subset(a, b))
+                combo_superset_layers[a] |= combo_plain_mask(b);
+        }
+    }
+    combo_supersets_ready = true;
+}
+
+/**
+ * True when no superset of this combo can still fire on the current layer.
+ */
+bool combo_is_terminal(uint16_t combo_index) {
+    if (!combo_supersets_ready)
+        build_combo_supersets();
+
+    combo_layer_mask_t supersets = combo_superset_layers[combo_index];
+    return !supersets || !combo_mask_active(supersets);
+}
+#endif
+
 /* ==========================================================================
  * CONFIG.H ADDITIONS
  * ==========================================================================
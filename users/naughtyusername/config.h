@@ -35,12 +35,25 @@
  */
 #define CHORDAL_HOLD
 #define PERMISSIVE_HOLD
-// #define SPECULATIVE_HOLD
+
+// Speculative hold (SPECULATIVE_HOLD = yes in rules.mk): a home row mod's
+// modifier goes to the host the moment the key is pressed, and is taken
+// back if the key turns out to be a tap - Ctrl/Shift + click with
+// HM_D/HM_F has no hold delay. Only mods in SPECULATIVE_HOLD_MODS
+// speculate: a stray GUI or Alt tap pops menus.
+#ifndef SPECULATIVE_HOLD_MODS
+#    define SPECULATIVE_HOLD_MODS (MOD_LCTL | MOD_LSFT)
+#endif
 
 // Flow Tap prevents misfires during fast typing
 // Lower = more aggressive (may miss intended holds)
 // Higher = less aggressive (may have more misfires)
 #define FLOW_TAP_TERM 125
+// Wider window for common same-hand rolls ("sd", "df", "lk"...), see
+// flow_rolls[] in naughtyusername.c
+#define FLOW_TAP_ROLL_TERM 150
+// Narrower window for same-hand pairs that aren't in flow_rolls[]
+#define FLOW_TAP_RARE_TERM 80
 
 /* ==========================================================================
  * TAPPING TERMS
@@ -84,6 +97,42 @@
 #define COMBO_MUST_TAP_PER_COMBO
 #define COMBO_SHOULD_TRIGGER
 
+/* ==========================================================================
+ * ADAPTIVE COMBO TERM (opt-in)
+ * ==========================================================================
+ * COMBO_ADAPTIVE_TERM = yes in rules.mk learns a tighter term per combo from
+ * how you actually chord (see combo_timing.c). Learned stats live in the
+ * EEPROM user datablock, laid out here so later users of the block can
+ * append after it.
+ */
+#ifdef COMBO_ADAPTIVE_TERM
+#    define COMBO_TIMING_MAX_COMBOS 48
+#    define COMBO_TIMING_EEPROM_OFFSET 0
+#    define COMBO_TIMING_EEPROM_SIZE (8 + COMBO_TIMING_MAX_COMBOS * 10)
+#else
+#    define COMBO_TIMING_EEPROM_SIZE 0
+#endif
+
+/* ==========================================================================
+ * COMBO STATS (opt-in)
+ * ==========================================================================
+ * COMBO_STATS = yes in rules.mk counts hits / misses per combo and serves
+ * them over raw HID (tools/combo_stats.py). Counters are kept right after
+ * the adaptive term block in the EEPROM user datablock.
+ */
+#ifdef COMBO_STATS
+#    define COMBO_STATS_MAX_COMBOS 48
+#    define COMBO_STATS_EEPROM_OFFSET COMBO_TIMING_EEPROM_SIZE
+#    define COMBO_STATS_EEPROM_SIZE (4 + COMBO_STATS_MAX_COMBOS * 4 * 2)
+#else
+#    define COMBO_STATS_EEPROM_SIZE 0
+#endif
+
+#if COMBO_TIMING_EEPROM_SIZE + COMBO_STATS_EEPROM_SIZE > 0
+#    define EECONFIG_USER_DATA_SIZE                                            \
+        (COMBO_TIMING_EEPROM_SIZE + COMBO_STATS_EEPROM_SIZE)
+#endif
+
 /* ==========================================================================
  * ONE-SHOT KEYS
  * ==========================================================================
@@ -0,0 +1,218 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * latency_trace.c - What do the userspace hooks actually cost?
+ *
+ * USB_POLLING_INTERVAL_MS 1 and asym_eager_defer_pk take care of the scan
+ * and USB ends. This measures the part in between, for every key press:
+ *
+ *   queue   matrix detect (record->event.time) → process_record_user()
+ *           Time spent buffered by the combo engine and the tap-hold
+ *           resolver. Milliseconds - event.time is a ms timestamp.
+ *
+ *   user    process_record_user() entry → post_process_record_user()
+ *           Our own handlers plus QMK's keycode processing, which is where
+ *           register_code() hands the report to the host driver. There is
+ *           no userspace hook on the USB send itself, so this is the
+ *           closest "report sent" point. Microseconds where the MCU has a
+ *           free-running hardware counter: the RP2040 1MHz timer, or the
+ *           Cortex-M3+ DWT cycle counter on STM32. ChibiOS system time is
+ *           tick-resolution, so anything else reports milliseconds.
+ *
+ * Only physical key presses are sampled. Presses one of our handlers
+ * swallows (return false) never reach post_process_record_user(), so they
+ * simply drop out, as do combo outputs (COMBO_EVENT records).
+ *
+ * The last LATENCY_TRACE_SIZE presses sit in a ring buffer. LAT_RPT types
+ * min/avg/max of both, e.g. "lat n32 q0/4/31ms u6/11/85us", and raw HID
+ * command 0x48 returns the same numbers.
+ *
+ * Compiled out completely unless LATENCY_TRACE = yes.
+ */
+
+#include "latency_trace.h"
+
+#if defined(MCU_RP)
+#    include "hardware/timer.h"
+#    define LATENCY_USER_US
+#elif defined(PROTOCOL_CHIBIOS) && defined(DWT_CTRL_CYCCNTENA_Msk) && \
+    defined(STM32_SYSCLK)
+#    define LATENCY_USER_DWT
+#    define LATENCY_USER_US
+#endif
+
+#ifdef LATENCY_USER_US
+#    define LATENCY_USER_UNIT "us"
+#else
+#    define LATENCY_USER_UNIT "ms"
+#endif
+
+typedef struct {
+    uint16_t queue_ms;
+    uint16_t user_us;
+} latency_sample_t;
+
+static latency_sample_t samples[LATENCY_TRACE_SIZE];
+static uint8_t sample_head = 0;
+static uint8_t sample_count = 0;
+
+// Entry timestamp of the press currently going through process_record
+static uint32_t entry_ticks = 0;
+static uint16_t entry_queue_ms = 0;
+static bool entry_valid = false;
+
+// Set while LAT_RPT is typing, so the report doesn't measure itself
+static bool reporting = false;
+
+// Raw counter for the user stage: 1MHz timer, CPU cycles or ms
+static uint32_t now_ticks(void) {
+#if defined(MCU_RP)
+    return timer_hw->timerawl;
+#elif defined(LATENCY_USER_DWT)
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+#else
+    return timer_read32();
+#endif
+}
+
+/* ==========================================================================
+ * HOOKS
+ * ==========================================================================
+ */
+
+/**
+ * First thing in process_record_user().
+ */
+void latency_trace_user_entry(keyrecord_t *record) {
+    entry_valid = !reporting && IS_KEYEVENT(record->event) &&
+                  record->event.pressed;
+    if (!entry_valid)
+        return;
+
+    entry_queue_ms = TIMER_DIFF_16(timer_read(), record->event.time);
+    entry_ticks = now_ticks();
+}
+
+/**
+ * From post_process_record_user(), after QMK has handled the keycode.
+ */
+void latency_trace_post(uint16_t keycode, keyrecord_t *record) {
+    if (!entry_valid)
+        return;
+    entry_valid = false;
+
+    // In LATENCY_USER_UNIT from here on
+    uint32_t user_us = now_ticks() - entry_ticks;
+#ifdef LATENCY_USER_DWT
+    user_us /= STM32_SYSCLK / 1000000;
+#endif
+    samples[sample_head].queue_ms = entry_queue_ms;
+    samples[sample_head].user_us = MIN(user_us, UINT16_MAX);
+    sample_head = (sample_head + 1) % LATENCY_TRACE_SIZE;
+    if (sample_count < LATENCY_TRACE_SIZE)
+        sample_count++;
+}
+
+/* ==========================================================================
+ * SUMMARY
+ * ==========================================================================
+ */
+
+typedef struct {
+    uint16_t min, avg, max;
+} latency_summary_t;
+
+static void summarize(latency_summary_t *queue, latency_summary_t *user) {
+    uint32_t queue_sum = 0, user_sum = 0;
+
+    *queue = (latency_summary_t){UINT16_MAX, 0, 0};
+    *user = (latency_summary_t){UINT16_MAX, 0, 0};
+
+    for (uint8_t i = 0; i < sample_count; i++) {
+        latency_sample_t *s = &samples[i];
+        queue->min = MIN(queue->min, s->queue_ms);
+        queue->max = MAX(queue->max, s->queue_ms);
+        user->min = MIN(user->min, s->user_us);
+        user->max = MAX(user->max, s->user_us);
+        queue_sum += s->queue_ms;
+        user_sum += s->user_us;
+    }
+
+    if (sample_count) {
+        queue->avg = queue_sum / sample_count;
+        user->avg = user_sum / sample_count;
+    } else {
+        queue->min = user->min = 0;
+    }
+}
+
+static void send_number(uint16_t value) {
+    const char *digits = get_u16_str(value, ' ');
+    while (*digits == ' ')
+        digits++;
+    send_string(digits);
+}
+
+// "min/avg/max"
+static void send_summary(const latency_summary_t *s) {
+    send_number(s->min);
+    send_char('/');
+    send_number(s->avg);
+    send_char('/');
+    send_number(s->max);
+}
+
+/**
+ * Types the summary, e.g. "lat n32 q0/4/31ms u6/11/85us". Bound to LAT_RPT.
+ */
+void latency_trace_report(void) {
+    latency_summary_t queue, user;
+    summarize(&queue, &user);
+
+    reporting = true;
+    send_string("lat n");
+    send_number(sample_count);
+    send_string(" q");
+    send_summary(&queue);
+    send_string("ms u");
+    send_summary(&user);
+    send_string(LATENCY_USER_UNIT);
+    reporting = false;
+}
+
+/* ==========================================================================
+ * RAW HID
+ * ==========================================================================
+ * 0x48 → [1] status, [2] sample count,
+ *        [3..14] queue min/avg/max (ms), user min/avg/max, LE u16
+ *        [15] user unit: 1 = us, 0 = ms (no hardware counter)
+ */
+#define LATENCY_TRACE_CMD_READ 0x48
+
+bool latency_trace_raw_hid(uint8_t *data, uint8_t length) {
+    if (data[0] != LATENCY_TRACE_CMD_READ)
+        return false;
+
+    latency_summary_t queue, user;
+    summarize(&queue, &user);
+
+    uint16_t values[] = {queue.min, queue.avg, queue.max,
+                         user.min,  user.avg,  user.max};
+    uint8_t *out = &data[3];
+
+    memset(&data[1], 0, length - 1);
+    data[2] = sample_count;
+    for (uint8_t i = 0; i < ARRAY_SIZE(values); i++) {
+        *out++ = values[i] & 0xFF;
+        *out++ = values[i] >> 8;
+    }
+#ifdef LATENCY_USER_US
+    *out = 1;
+#endif
+    return true;
+}
@@ -0,0 +1,22 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * latency_trace.h - Key event latency instrumentation (opt-in)
+ *
+ * Enable with LATENCY_TRACE = yes in rules.mk. Tap LAT_RPT to type a
+ * summary, or read it over raw HID. See latency_trace.c.
+ */
+
+#pragma once
+
+#include "naughtyusername.h"
+
+// Presses kept in the ring buffer
+#ifndef LATENCY_TRACE_SIZE
+#    define LATENCY_TRACE_SIZE 32
+#endif
+
+void latency_trace_user_entry(keyrecord_t *record);
+void latency_trace_post(uint16_t keycode, keyrecord_t *record);
+void latency_trace_report(void);
+bool latency_trace_raw_hid(uint8_t *data, uint8_t length);
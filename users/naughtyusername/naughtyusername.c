@@ -23,59 +23,153 @@ before compilation. Required for arrays that QMK's introspection needs to find
 #include "numword.h"
 #include "secrets.h"
 
+#ifdef COMBO_ADAPTIVE_TERM
+#    include "combo_timing.h"
+#endif
+#ifdef COMBO_STATS
+#    include "combo_stats.h"
+#endif
+#ifdef COMBO_EARLY_FIRE
+#    include "combo_early.h"
+#endif
+#ifdef LATENCY_TRACE
+#    include "latency_trace.h"
+#endif
+#ifdef TYPING_SPEED_TERM
+#    include "typing_speed.h"
+#endif
+
 #ifdef LEADER_ENABLE
 #    include "process_leader.h"
 #endif
 
 /* ==========================================================================
- * TAPPING TERM PER KEY
+ * HOLD-TAP PROFILES
  * ==========================================================================
- * Different fingers have different strengths and speeds.
- * Pinkies are slower, so they get a longer tapping term.
+ * Every per-key hold-tap setting lives in tables instead of a switch per
+ * QMK callback: tapping term, quick tap term, and whether chordal hold is
+ * skipped for the key. A key resolves in this order:
+ *
+ *   1. holdtap_keys[]    - special keys by keycode (thumbs, SYS access)
+ *   2. holdtap_fingers[] - any other mod-tap/layer-tap, by the finger that
+ *                          presses it (hold_tap_fingers[][] in keymap.c)
+ *   3. the config.h defaults
+ *
+ * Going by position means the pinky key keeps pinky timing on every layer,
+ * whatever keycode sits there - no need to list HM_A, the VIM/GAMING
+ * versions of it, and so on.
+ *
+ * QMK asks get_tapping_term() and friends about the same pending key over
+ * and over while it decides tap vs hold, so the keycode lookup remembers
+ * the last keycode it resolved - the repeat calls are a single compare.
+ * The finger lookup is just an array read.
+ *
+ * With TYPING_SPEED_TERM, HT_SPEED_SCALED terms also shift with typing
+ * speed (typing_speed.c). Thumbs and SYS keys stay fixed - those holds are
+ * always deliberate.
  */
-uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
-    switch (keycode) {
-    // Pinkies get longer tapping term (weaker fingers)
-    case HM_A:
-    case HM_SCLN:
-        return 175;
-
-    // All other home row mods - consistent 175ms timing
-    case HM_S:
-    case HM_D:
-    case HM_F:
-    case HM_J:
-    case HM_K:
-    case HM_L:
-        return 175;
+enum holdtap_flags {
+    HT_CHORDAL_EXEMPT = 1 << 0, // Hold even with same-hand keys
+    HT_SPEED_SCALED   = 1 << 1, // Term follows typing speed
+    HT_SPECULATIVE    = 1 << 2, // Mod may be sent early (SPECULATIVE_HOLD)
+};
+
+typedef struct {
+    uint16_t keycode;
+    uint16_t tapping_term;
+    uint16_t quick_tap_term;
+    uint8_t  flags;
+} holdtap_profile_t;
+
+// clang-format off
+static const holdtap_profile_t holdtap_keys[] = {
+    // Thumb layer keys: quick tap off - every hold is intentional, Flow
+    // Tap handles rolling. Chordal hold off so Space/Enter + a same-hand
+    // key still triggers the layer.
+    { SP_RAI,            TAPPING_TERM, 0,              HT_CHORDAL_EXEMPT },
+    { SP_LOW,            TAPPING_TERM, 0,              HT_CHORDAL_EXEMPT },
+    { ENT_LOW,           TAPPING_TERM, 0,              HT_CHORDAL_EXEMPT },
 
     // SYS layer access — 1 second deliberate hold
-    case LT(_SYS, KC_Z):
-    case LT(_SYS, KC_SLSH):
-        return 1000;
-    default:
-        return TAPPING_TERM; // Use default from config.h
+    { LT(_SYS, KC_Z),    1000,         0,              0 },
+    { LT(_SYS, KC_SLSH), 1000,         0,              0 },
+};
+
+/* Different fingers have different strengths and speeds. Pinkies are
+ * slower, so that's where a longer term goes - kept at 175 for now, same
+ * as the rest. The keycode field is unused here.
+ */
+static const holdtap_profile_t holdtap_fingers[FNG_COUNT] = {
+    [FNG_NO] = { KC_NO, TAPPING_TERM, QUICK_TAP_TERM, 0 },
+    [FNG_LP] = { KC_NO, 175,          QUICK_TAP_TERM, HT_SPEED_SCALED | HT_SPECULATIVE },
+    [FNG_LR] = { KC_NO, 175,          QUICK_TAP_TERM, HT_SPEED_SCALED | HT_SPECULATIVE },
+    [FNG_LM] = { KC_NO, 175,          QUICK_TAP_TERM, HT_SPEED_SCALED | HT_SPECULATIVE },
+    [FNG_LI] = { KC_NO, 175,          QUICK_TAP_TERM, HT_SPEED_SCALED | HT_SPECULATIVE },
+    [FNG_RI] = { KC_NO, 175,          QUICK_TAP_TERM, HT_SPEED_SCALED | HT_SPECULATIVE },
+    [FNG_RM] = { KC_NO, 175,          QUICK_TAP_TERM, HT_SPEED_SCALED | HT_SPECULATIVE },
+    [FNG_RR] = { KC_NO, 175,          QUICK_TAP_TERM, HT_SPEED_SCALED | HT_SPECULATIVE },
+    [FNG_RP] = { KC_NO, 175,          QUICK_TAP_TERM, HT_SPEED_SCALED | HT_SPECULATIVE },
+};
+// clang-format on
+
+// Keymaps without a finger map get the defaults everywhere
+__attribute__((weak)) const uint8_t PROGMEM
+    hold_tap_fingers[MATRIX_ROWS][MATRIX_COLS] = {{FNG_NO}};
+
+// Keycode table entry, or NULL if the keycode isn't listed
+static const holdtap_profile_t *holdtap_key_profile(uint16_t keycode) {
+    static uint16_t memo_keycode = KC_NO;
+    static const holdtap_profile_t *memo = NULL;
+
+    if (keycode == memo_keycode) {
+        return memo;
+    }
+
+    memo_keycode = keycode;
+    memo = NULL;
+    for (uint8_t i = 0; i < ARRAY_SIZE(holdtap_keys); i++) {
+        if (holdtap_keys[i].keycode == keycode) {
+            memo = &holdtap_keys[i];
+            break;
+        }
     }
+    return memo;
 }
 
-/* ==========================================================================
- * QUICK TAP TERM PER KEY
- * ==========================================================================
- * Quick tap prevents accidental holds when double-tapping a key.
- * For layer keys (Space/Enter), we disable it so every hold is intentional.
- * Flow Tap already handles rolling protection for these keys.
- */
-uint16_t get_quick_tap_term(uint16_t keycode, keyrecord_t *record) {
-    switch (keycode) {
-        case SP_RAI:
-        case SP_LOW:
-        case ENT_LOW:
-        case LT(_SYS, KC_Z):
-        case LT(_SYS, KC_SLSH):
-            return 0; // disable quick tap — every hold is intentional, Flow Tap handles rolling
-        default:
-            return QUICK_TAP_TERM;
+static const holdtap_profile_t *holdtap_profile(uint16_t keycode,
+                                                keyrecord_t *record) {
+    const holdtap_profile_t *profile = holdtap_key_profile(keycode);
+    if (profile != NULL) {
+        return profile;
+    }
+
+    // Combos and other synthetic events have no real matrix position
+    if (record == NULL || !IS_KEYEVENT(record->event) ||
+        !(IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode))) {
+        return &holdtap_fingers[FNG_NO];
     }
+
+    keypos_t key = record->event.key;
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return &holdtap_fingers[FNG_NO];
+    }
+
+    uint8_t finger = pgm_read_byte(&hold_tap_fingers[key.row][key.col]);
+    return &holdtap_fingers[finger < FNG_COUNT ? finger : FNG_NO];
+}
+
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
+    const holdtap_profile_t *profile = holdtap_profile(keycode, record);
+#ifdef TYPING_SPEED_TERM
+    if (profile->flags & HT_SPEED_SCALED) {
+        return profile->tapping_term + typing_speed_hold_offset();
+    }
+#endif
+    return profile->tapping_term;
+}
+
+uint16_t get_quick_tap_term(uint16_t keycode, keyrecord_t *record) {
+    return holdtap_profile(keycode, record)->quick_tap_term;
 }
 
 /* ==========================================================================
@@ -84,17 +178,15 @@ uint16_t get_quick_tap_term(uint16_t keycode, keyrecord_t *record) {
  * Chordal hold is a QMK feature that helps with home row mods.
  * It prevents accidental mod activation when rolling keys quickly.
  *
- * We override it here to allow SP_RAI and ENT_LOW to work on the same hand
- * (otherwise holding Space+another key on the same hand wouldn't trigger
- * Raise).
+ * Keys flagged HT_CHORDAL_EXEMPT above (SP_RAI, SP_LOW, ENT_LOW) work on
+ * the same hand (otherwise holding Space+another key on the same hand
+ * wouldn't trigger Raise).
  */
 bool get_chordal_hold(uint16_t tap_hold_keycode, keyrecord_t *tap_hold_record,
                       uint16_t other_keycode, keyrecord_t *other_record) {
-    switch (tap_hold_keycode) {
-    // Allow these to trigger hold even with same-hand keys
-    case SP_RAI:
-    case ENT_LOW:
-    case SP_LOW:
+    const holdtap_profile_t *profile =
+        holdtap_profile(tap_hold_keycode, tap_hold_record);
+    if (profile->flags & HT_CHORDAL_EXEMPT) {
         return true;
     }
     // Use default chordal hold behavior for everything else
@@ -107,34 +199,210 @@ bool get_chordal_hold(uint16_t tap_hold_keycode, keyrecord_t *tap_hold_record,
  * Flow Tap helps with fast typing on home row mods. When you type quickly,
  * it registers taps instead of holds, preventing "thE" when you meant "the".
  *
- * We only enable it for alpha keys and common punctuation.
+ * We only enable it for alpha keys and common punctuation. Which tap
+ * keycodes count is a 256-bit set built at compile time, so the check is
+ * one shift and mask per key.
  */
+#define FLOW_WORD(kc) ((kc) >> 5)
+#define FLOW_BIT(kc) (1UL << ((kc) & 31))
+// Bits of [lo, hi] that fall in word w
+#define FLOW_RANGE(w, lo, hi)                                                  \
+    ((FLOW_WORD(lo) <= (w) && (w) <= FLOW_WORD(hi))                            \
+         ? ((FLOW_WORD(hi) == (w) ? (FLOW_BIT(hi) << 1) - 1 : ~0UL) &         \
+            (FLOW_WORD(lo) == (w) ? ~(FLOW_BIT(lo) - 1) : ~0UL))              \
+         : 0)
+#define FLOW_ONE(w, kc) (FLOW_WORD(kc) == (w) ? FLOW_BIT(kc) : 0)
+
+#define FLOW_KEYS(w)                                                           \
+    (FLOW_RANGE(w, KC_A, KC_Z) | FLOW_ONE(w, KC_DOT) |                       \
+     FLOW_ONE(w, KC_COMM) | FLOW_ONE(w, KC_SCLN) | FLOW_ONE(w, KC_SLSH) |    \
+     FLOW_ONE(w, KC_SPC))
+
+static const uint32_t flow_tap_keys[8] = {
+    FLOW_KEYS(0), FLOW_KEYS(1), FLOW_KEYS(2), FLOW_KEYS(3),
+    FLOW_KEYS(4), FLOW_KEYS(5), FLOW_KEYS(6), FLOW_KEYS(7),
+};
+
 bool is_flow_tap_key(uint16_t keycode) {
     // Disable Flow Tap when using modifier hotkeys
     if ((get_mods() & (MOD_MASK_CG | MOD_BIT_LALT)) != 0) {
         return false;
     }
 
-    switch (get_tap_keycode(keycode)) {
-    case KC_A ... KC_Z:
-    case KC_DOT:
-    case KC_COMM:
-    case KC_SCLN:
-    case KC_SLSH:
-    case KC_SPC:
-        return true;
+    // Shifted and modded keycodes (KC_COLN, LCTL(KC_A)...) aren't flow keys
+    uint16_t tap = get_tap_keycode(keycode);
+    if (tap > 0xFF) {
+        return false;
     }
-    return false;
+    return (flow_tap_keys[FLOW_WORD(tap)] & FLOW_BIT(tap)) != 0;
+}
+
+/* Bigrams: a flow tap pair of letters gets
+ *
+ *   same hand, common roll       → FLOW_TAP_ROLL_TERM (wider)
+ *   same hand, anything else     → FLOW_TAP_RARE_TERM (narrower)
+ *   opposite hands               → FLOW_TAP_TERM
+ *
+ * A same-hand pair that isn't a common roll is more likely a mod + key
+ * chord than typing, so its hold resolves sooner. Opposite-hand pairs keep
+ * the normal window; chordal hold already sorts those out.
+ *
+ * flow_rolls[] marks the common same-hand rolls of English and code, one
+ * 26-bit row per first letter (bit = second letter), QWERTY hands. It is
+ * hand-picked, not generated from a corpus.
+ */
+#define ROLL_ROW(c) [(c) - 'a']
+#define ROLL(c) (1UL << ((c) - 'a'))
+
+// clang-format off
+static const uint32_t flow_left_hand =
+    ROLL('q') | ROLL('w') | ROLL('e') | ROLL('r') | ROLL('t') |
+    ROLL('a') | ROLL('s') | ROLL('d') | ROLL('f') | ROLL('g') |
+    ROLL('z') | ROLL('x') | ROLL('c') | ROLL('v') | ROLL('b');
+
+static const uint32_t PROGMEM flow_rolls[26] = {
+    // Left hand
+    ROLL_ROW('a') = ROLL('b') | ROLL('c') | ROLL('d') | ROLL('f') | ROLL('g') | ROLL('r') |
+                    ROLL('s') | ROLL('t') | ROLL('v') | ROLL('w') | ROLL('x'),
+    ROLL_ROW('b') = ROLL('a') | ROLL('e') | ROLL('r') | ROLL('s'),
+    ROLL_ROW('c') = ROLL('a') | ROLL('c') | ROLL('d') | ROLL('e') | ROLL('r') | ROLL('s') |
+                    ROLL('t'),
+    ROLL_ROW('d') = ROLL('a') | ROLL('d') | ROLL('e') | ROLL('f') | ROLL('r') | ROLL('s'),
+    ROLL_ROW('e') = ROLL('a') | ROLL('c') | ROLL('d') | ROLL('e') | ROLL('f') | ROLL('g') |
+                    ROLL('r') | ROLL('s') | ROLL('t') | ROLL('v') | ROLL('w') | ROLL('x'),
+    ROLL_ROW('f') = ROLL('a') | ROLL('d') | ROLL('e') | ROLL('f') | ROLL('r') | ROLL('t'),
+    ROLL_ROW('g') = ROLL('a') | ROLL('e') | ROLL('r') | ROLL('s'),
+    ROLL_ROW('r') = ROLL('a') | ROLL('c') | ROLL('d') | ROLL('e') | ROLL('f') | ROLL('g') |
+                    ROLL('r') | ROLL('s') | ROLL('t') | ROLL('v'),
+    ROLL_ROW('s') = ROLL('a') | ROLL('c') | ROLL('d') | ROLL('e') | ROLL('f') | ROLL('s') |
+                    ROLL('t') | ROLL('w'),
+    ROLL_ROW('t') = ROLL('a') | ROLL('e') | ROLL('r') | ROLL('s') | ROLL('t') | ROLL('w'),
+    ROLL_ROW('v') = ROLL('a') | ROLL('e') | ROLL('s'),
+    ROLL_ROW('w') = ROLL('a') | ROLL('e') | ROLL('r') | ROLL('s'),
+    ROLL_ROW('x') = ROLL('a') | ROLL('t'),
+    ROLL_ROW('z') = ROLL('a') | ROLL('e'),
+
+    // Right hand
+    ROLL_ROW('h') = ROLL('i') | ROLL('o') | ROLL('u') | ROLL('y'),
+    ROLL_ROW('i') = ROLL('k') | ROLL('l') | ROLL('m') | ROLL('n') | ROLL('o') | ROLL('p'),
+    ROLL_ROW('j') = ROLL('k') | ROLL('o') | ROLL('u'),
+    ROLL_ROW('k') = ROLL('i') | ROLL('l') | ROLL('n') | ROLL('y'),
+    ROLL_ROW('l') = ROLL('i') | ROLL('k') | ROLL('l') | ROLL('o') | ROLL('u') | ROLL('y'),
+    ROLL_ROW('m') = ROLL('i') | ROLL('l') | ROLL('m') | ROLL('o') | ROLL('p') | ROLL('u') |
+                    ROLL('y'),
+    ROLL_ROW('n') = ROLL('i') | ROLL('k') | ROLL('l') | ROLL('n') | ROLL('o') | ROLL('u') |
+                    ROLL('y'),
+    ROLL_ROW('o') = ROLL('h') | ROLL('i') | ROLL('k') | ROLL('l') | ROLL('m') | ROLL('n') |
+                    ROLL('o') | ROLL('p') | ROLL('u'),
+    ROLL_ROW('p') = ROLL('h') | ROLL('i') | ROLL('l') | ROLL('o') | ROLL('p') | ROLL('u'),
+    ROLL_ROW('u') = ROLL('i') | ROLL('l') | ROLL('m') | ROLL('n') | ROLL('p'),
+    ROLL_ROW('y') = ROLL('l') | ROLL('o'),
+};
+// clang-format on
+
+static uint16_t flow_tap_pair_term(uint16_t prev, uint16_t tap) {
+    if (prev < KC_A || prev > KC_Z || tap < KC_A || tap > KC_Z) {
+        return FLOW_TAP_TERM; // Punctuation / space
+    }
+
+    uint8_t p = prev - KC_A;
+    uint8_t t = tap - KC_A;
+    if (((flow_left_hand >> p) ^ (flow_left_hand >> t)) & 1) {
+        return FLOW_TAP_TERM;
+    }
+    if ((pgm_read_dword(&flow_rolls[p]) >> t) & 1) {
+        return FLOW_TAP_ROLL_TERM;
+    }
+    return FLOW_TAP_RARE_TERM;
 }
 
 uint16_t get_flow_tap_term(uint16_t keycode, keyrecord_t *record,
                            uint16_t prev_keycode) {
-    if (is_flow_tap_key(keycode) && is_flow_tap_key(prev_keycode)) {
-        return FLOW_TAP_TERM; // Defined in config.h
+    if (!is_flow_tap_key(keycode) || !is_flow_tap_key(prev_keycode)) {
+        return 0; // Disable Flow Tap for non-alpha keys
     }
-    return 0; // Disable Flow Tap for non-alpha keys
+
+    uint16_t term = flow_tap_pair_term(get_tap_keycode(prev_keycode),
+                                       get_tap_keycode(keycode));
+#ifdef TYPING_SPEED_TERM
+    term += typing_speed_flow_offset();
+#endif
+    return term;
 }
 
+/* ==========================================================================
+ * SPECULATIVE HOLD
+ * ==========================================================================
+ * With SPECULATIVE_HOLD (opt-in, rules.mk) QMK sends a mod-tap's modifier
+ * as soon as the key goes down and retracts it cleanly if the key resolves
+ * to a tap. We only allow it for the home row mods (HT_SPECULATIVE finger
+ * positions) whose mods are all in SPECULATIVE_HOLD_MODS.
+ *
+ * Mid-roll - pressed inside the Flow Tap window of the previous key - the
+ * press is going to be a tap anyway, so don't flash the mod at the host.
+ * Presses are recorded from pre_process_record_user(), in the order they
+ * happened. The combo engine can hold a press back while later ones are
+ * recorded, so the previous key is looked up by the press being decided.
+ */
+#ifdef SPECULATIVE_HOLD
+#    define SPEC_HISTORY 8 // Presses the combo engine may hold back, and one
+
+static struct {
+    keypos_t key;
+    uint16_t time;
+    uint16_t keycode;
+} spec_presses[SPEC_HISTORY];
+static uint8_t spec_head = 0;
+
+static void process_speculative_hold(uint16_t keycode, keyrecord_t *record) {
+    if (!IS_KEYEVENT(record->event) || !record->event.pressed) {
+        return;
+    }
+    spec_head = (spec_head + 1) % SPEC_HISTORY;
+    spec_presses[spec_head].key = record->event.key;
+    spec_presses[spec_head].time = record->event.time;
+    spec_presses[spec_head].keycode = keycode;
+}
+
+// Press recorded just before this one, SPEC_HISTORY if there is none
+static uint8_t spec_prev_press(keyrecord_t *record) {
+    for (uint8_t n = 0; n < SPEC_HISTORY - 1; n++) {
+        uint8_t i = (spec_head + SPEC_HISTORY - n) % SPEC_HISTORY;
+        if (spec_presses[i].time == record->event.time &&
+            KEYEQ(spec_presses[i].key, record->event.key)) {
+            return (i + SPEC_HISTORY - 1) % SPEC_HISTORY;
+        }
+    }
+    return SPEC_HISTORY;
+}
+
+bool get_speculative_hold(uint16_t keycode, keyrecord_t *record) {
+    if (!IS_QK_MOD_TAP(keycode) ||
+        !(holdtap_profile(keycode, record)->flags & HT_SPECULATIVE)) {
+        return false;
+    }
+
+    // Left/right doesn't matter, only which mods
+    uint8_t mods = QK_MOD_TAP_GET_MODS(keycode) & 0x0F;
+    if ((mods & ~SPECULATIVE_HOLD_MODS) != 0) {
+        return false;
+    }
+
+    uint8_t prev = spec_prev_press(record);
+    if (prev == SPEC_HISTORY) {
+        return true;
+    }
+    uint16_t flow_term =
+        get_flow_tap_term(keycode, record, spec_presses[prev].keycode);
+    if (flow_term > 0 &&
+        TIMER_DIFF_16(record->event.time, spec_presses[prev].time) <
+            flow_term) {
+        return false;
+    }
+    return true;
+}
+#endif
+
 /* ==========================================================================
  * WEAK KEYMAP FUNCTIONS
  * ==========================================================================
@@ -161,6 +429,32 @@ __attribute__((weak)) void keyboard_post_init_keymap(void) {
     // Nothing by default
 }
 
+/* ==========================================================================
+ * PRE PROCESS RECORD USER
+ * ==========================================================================
+ * Runs for every raw key event BEFORE the combo engine buffers it, so this
+ * is the only place that sees true press/release timing on combo keys.
+ * Observers only - always returns true.
+ */
+bool pre_process_record_user(uint16_t keycode, keyrecord_t *record) {
+#ifdef TYPING_SPEED_TERM
+    process_typing_speed(record);
+#endif
+#ifdef SPECULATIVE_HOLD
+    process_speculative_hold(keycode, record);
+#endif
+#ifdef COMBO_ADAPTIVE_TERM
+    process_combo_timing(record);
+#endif
+#ifdef COMBO_STATS
+    process_combo_stats(record);
+#endif
+#ifdef COMBO_EARLY_FIRE
+    process_combo_early(record);
+#endif
+    return true;
+}
+
 /* ==========================================================================
  * PROCESS RECORD USER
  * ==========================================================================
@@ -173,6 +467,10 @@ __attribute__((weak)) void keyboard_post_init_keymap(void) {
  *   4. Return true to continue normal processing
  */
 bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+#ifdef LATENCY_TRACE
+    latency_trace_user_entry(record);
+#endif
+
     if (!process_record_num_word(keycode, record)) {
         return false;
     }
@@ -205,6 +503,13 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
         case KC_EQEQ:
             SEND_STRING("==");
             return false;
+
+#ifdef LATENCY_TRACE
+        // Type the key latency summary
+        case LAT_RPT:
+            latency_trace_report();
+            return false;
+#endif
         }
     }
 
@@ -212,6 +517,18 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
     return process_record_keymap(keycode, record);
 }
 
+/* ==========================================================================
+ * POST PROCESS RECORD USER
+ * ==========================================================================
+ * Runs after QMK has handled the keycode (and sent the report for plain
+ * keys). Only used for instrumentation for now.
+ */
+void post_process_record_user(uint16_t keycode, keyrecord_t *record) {
+#ifdef LATENCY_TRACE
+    latency_trace_post(keycode, record);
+#endif
+}
+
 /* ==========================================================================
  * LAYER STATE SET USER
  * ==========================================================================
@@ -245,7 +562,74 @@ void matrix_scan_user(void) { matrix_scan_keymap(); }
  * Called once after the keyboard initializes. Good for setting up
  * default states, RGB modes, etc.
  */
-void keyboard_post_init_user(void) { keyboard_post_init_keymap(); }
+void keyboard_post_init_user(void) {
+#ifdef COMBO_ADAPTIVE_TERM
+    combo_timing_init();
+#endif
+#ifdef COMBO_STATS
+    combo_stats_init();
+#endif
+    keyboard_post_init_keymap();
+}
+
+/* ==========================================================================
+ * HOUSEKEEPING TASK USER
+ * ==========================================================================
+ * Called every main loop iteration. Background work that isn't tied to a
+ * keypress (EEPROM write-back etc.) goes here.
+ */
+void housekeeping_task_user(void) {
+#ifdef COMBO_ADAPTIVE_TERM
+    combo_timing_task();
+#endif
+#ifdef COMBO_STATS
+    combo_stats_task();
+#endif
+#ifdef COMBO_EARLY_FIRE
+    combo_early_task();
+#endif
+}
+
+/* ==========================================================================
+ * EECONFIG INIT USER
+ * ==========================================================================
+ * Called when EEPROM is reset (EE_CLR or a fresh board). Wipe learned data.
+ */
+void eeconfig_init_user(void) {
+#ifdef COMBO_ADAPTIVE_TERM
+    combo_timing_reset();
+#endif
+#ifdef COMBO_STATS
+    combo_stats_reset();
+#endif
+}
+
+#if defined(RAW_ENABLE) && !defined(VIA_ENABLE)
+/* ==========================================================================
+ * RAW HID
+ * ==========================================================================
+ * Userspace telemetry commands (0x40 and up, clear of VIA's ids). Each
+ * module gets a look at the packet and answers in place; unknown commands
+ * are echoed back with 0xFF so the host isn't left waiting. None of our
+ * boards run VIA - if one ever does, VIA owns raw_hid_receive() and this
+ * has to move behind its custom channel.
+ */
+void raw_hid_receive(uint8_t *data, uint8_t length) {
+    bool handled = false;
+
+#    ifdef COMBO_STATS
+    handled = handled || combo_stats_raw_hid(data, length);
+#    endif
+#    ifdef LATENCY_TRACE
+    handled = handled || latency_trace_raw_hid(data, length);
+#    endif
+
+    if (!handled) {
+        data[1] = 0xFF;
+    }
+    raw_hid_send(data, length);
+}
+#endif // RAW_ENABLE && !VIA_ENABLE
 
 #ifdef LEADER_ENABLE
 /* ==========================================================================
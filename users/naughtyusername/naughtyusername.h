@@ -56,6 +56,10 @@ enum userspace_keycodes {
 
     NUMWORD, // Num Word - combo-activated numbers layer lock
 
+#ifdef LATENCY_TRACE
+    LAT_RPT, // Type a key latency summary (latency_trace.c)
+#endif
+
     // Add more shared keycodes above this line
     NEW_SAFE_RANGE // Keymaps can use this for their own keycodes
 };
@@ -86,6 +90,31 @@ enum userspace_keycodes {
 #define HM_L RALT_T(KC_L)
 #define HM_SCLN RGUI_T(KC_SCLN)
 
+/* ==========================================================================
+ * FINGER PROFILES
+ * ==========================================================================
+ * Which finger presses each physical key. Each keymap lays these out with
+ * the ___FINGER_*___ wrappers (wrappers.h) into hold_tap_fingers[][], and
+ * get_tapping_term() uses them to time any hold-tap key by where it sits
+ * instead of by keycode - so the pinky key gets pinky timing on every layer.
+ *
+ * FNG_NO (thumbs, outer/extra keys) falls back to the config.h defaults.
+ */
+enum userspace_fingers {
+    FNG_NO = 0, // Must be 0: LAYOUT() fills unused matrix slots with 0
+    FNG_LP,     // Left pinky
+    FNG_LR,     // Left ring
+    FNG_LM,     // Left middle
+    FNG_LI,     // Left index
+    FNG_RI,     // Right index
+    FNG_RM,     // Right middle
+    FNG_RR,     // Right ring
+    FNG_RP,     // Right pinky
+    FNG_COUNT
+};
+
+extern const uint8_t hold_tap_fingers[MATRIX_ROWS][MATRIX_COLS];
+
 /* ==========================================================================
  * LAYER TAP SHORTCUTS
  * ==========================================================================
@@ -14,6 +14,55 @@
 SRC += naughtyusername.c
 SRC += $(USER_PATH)/numword.c
 
+# Adaptive combo term - learns tighter combo windows from your typing.
+# Opt-in: set COMBO_ADAPTIVE_TERM = yes in a keymap's rules.mk
+COMBO_ADAPTIVE_TERM ?= no
+ifeq ($(strip $(COMBO_ADAPTIVE_TERM)), yes)
+    SRC += $(USER_PATH)/combo_timing.c
+    OPT_DEFS += -DCOMBO_ADAPTIVE_TERM
+endif
+
+# Combo hit / miss counters, read over raw HID with tools/combo_stats.py.
+# Opt-in: set COMBO_STATS = yes in a keymap's rules.mk
+COMBO_STATS ?= no
+ifeq ($(strip $(COMBO_STATS)), yes)
+    SRC += $(USER_PATH)/combo_stats.c
+    OPT_DEFS += -DCOMBO_STATS
+    RAW_ENABLE = yes
+endif
+
+# Terminal combos fire as soon as their keys are down, no term wait.
+# Opt-in: set COMBO_EARLY_FIRE = yes in a keymap's rules.mk
+COMBO_EARLY_FIRE ?= no
+ifeq ($(strip $(COMBO_EARLY_FIRE)), yes)
+    SRC += $(USER_PATH)/combo_early.c
+    OPT_DEFS += -DCOMBO_EARLY_FIRE
+endif
+
+# Key latency instrumentation - LAT_RPT types a summary, also over raw HID.
+# Opt-in: set LATENCY_TRACE = yes in a keymap's rules.mk
+LATENCY_TRACE ?= no
+ifeq ($(strip $(LATENCY_TRACE)), yes)
+    SRC += $(USER_PATH)/latency_trace.c
+    OPT_DEFS += -DLATENCY_TRACE
+    RAW_ENABLE = yes
+endif
+
+# Home row tapping / flow tap terms that follow typing speed.
+# Opt-in: set TYPING_SPEED_TERM = yes in a keymap's rules.mk
+TYPING_SPEED_TERM ?= no
+ifeq ($(strip $(TYPING_SPEED_TERM)), yes)
+    SRC += $(USER_PATH)/typing_speed.c
+    OPT_DEFS += -DTYPING_SPEED_TERM
+endif
+
+# Speculative hold - home row Ctrl/Shift sent on press, retracted on tap.
+# Opt-in: set SPECULATIVE_HOLD = yes in a keymap's rules.mk
+SPECULATIVE_HOLD ?= no
+ifeq ($(strip $(SPECULATIVE_HOLD)), yes)
+    OPT_DEFS += -DSPECULATIVE_HOLD
+endif
+
 # =============================================================================
 # SHARED FEATURES
 # =============================================================================
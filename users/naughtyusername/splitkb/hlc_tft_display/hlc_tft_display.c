@@ -8,17 +8,23 @@
 //   y=5    Layer name (text, colored per layer)
 //   y=40   WPM counter ("XXX wpm", magenta)
 //   y=75   Lock indicators (Cap Num Scr, cyan)
-//   y=140  Tux pixel art (100×100, cyan/magenta recolor)
+//   y=140  Tux pixel art (100×100, cyan/magenta recolor), or with
+//          HLC_WPM_BIG_DIGITS a three-digit WPM gauge in its place
 //
 // Idle animation: Game of Life fills the full display after 30s,
 // snaps back to info display on any input.
+//
+// Rendering: a 4bpp palette-indexed framebuffer, expanded to RGB565 on
+// the way out to the panel. Quantum Painter only rasterises the fonts and
+// images once at boot.
 
 #include "halcyon.h"
 #include "hlc_tft_display.h"
 #include "naughtyusername.h"
 
 #include "hardware/structs/rosc.h"
-#include <stdio.h>
+#include "hardware/timer.h"
+#include "spi_master.h"
 
 // Font
 #include "graphics/fonts/Retron2000-27.qff.h"
@@ -27,6 +33,20 @@
 // Tux image (mono4 palette — 4-shade grayscale, recolorable)
 #include "graphics/tux_100.qgf.h"
 
+#ifdef HLC_WPM_BIG_DIGITS
+// Big WPM digits (mono2, 75×105)
+#    include "graphics/numbers/0.qgf.h"
+#    include "graphics/numbers/1.qgf.h"
+#    include "graphics/numbers/2.qgf.h"
+#    include "graphics/numbers/3.qgf.h"
+#    include "graphics/numbers/4.qgf.h"
+#    include "graphics/numbers/5.qgf.h"
+#    include "graphics/numbers/6.qgf.h"
+#    include "graphics/numbers/7.qgf.h"
+#    include "graphics/numbers/8.qgf.h"
+#    include "graphics/numbers/9.qgf.h"
+#endif
+
 // ==========================================================================
 // Layer names and colors
 // ==========================================================================
@@ -70,16 +90,23 @@ static const display_hsv_t layer_colors[] = {
 static const char *lock_labels[] = { "C", "N", "S" };
 
 // ==========================================================================
-// Display objects and state
+// Layout constants
 // ==========================================================================
 
-static painter_font_handle_t font;
-static painter_font_handle_t font_underline;
+#define LAYER_NAME_Y  8
+#define WPM_Y         42
+#define LOCK_Y        76
+#define TUX_X         17    // (135 - 100) / 2 = 17.5, rounded down
+#define TUX_Y         112   // Tight after locks, leaves 28px bottom padding
+#define TUX_SIZE      100   // tux_100.qgf is 100×100
+#define IDLE_TIMEOUT  30000 // 30 seconds of no input → Game of Life
 
-static uint8_t lcd_surface_fb[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(135, 240, 16)];
+// ==========================================================================
+// Display objects and state
+// ==========================================================================
 
 painter_device_t lcd;
-painter_device_t lcd_surface;
+painter_device_t lcd_surface; // Boot-time scratch only, see below
 
 // State tracking — only redraw what changed
 static led_t last_led_state = {0};
@@ -87,19 +114,298 @@ static layer_state_t last_layer = 0;
 static uint8_t last_wpm = 255;  // Impossible initial value forces first draw
 static bool tux_drawn = false;
 static bool idle_mode = false;
-static bool fonts_loaded = false;
-static bool display_dirty = true; // Only flush surface to LCD when something changed
 
 // ==========================================================================
-// Layout constants
+// Indexed framebuffer — 4bpp, 16-color palette
 // ==========================================================================
+// The UI only ever uses a handful of colors (the layer colors, WPM and
+// lock colors, Tux's four shades), so the live framebuffer stores a 4-bit
+// palette index per pixel, two per byte with even x in the high nibble.
+// That's 16KB instead of the 64KB an rgb565 surface needs, and every
+// redraw writes a quarter of the bytes. Palette entries hold the
+// panel-native RGB565 value; the flush expands rows on the fly.
+//
+// Quantum Painter can't draw into an indexed buffer, so it only runs at
+// boot: fonts, Tux and the digit images are rendered onto an rgb565
+// scratch surface and read back as masks / palette indices. The scratch
+// surface shares display_ram with the framebuffer and flush buffers.
+// Nothing draws through lcd_surface after load_display_assets(), and
+// display_ram is zeroed before the first frame.
+
+#define PALETTE_SIZE      16
+#define FB_STRIDE         ((LCD_WIDTH + 1) / 2)
+#define FLUSH_CHUNK_ROWS  16
+
+#ifdef HLC_WPM_BIG_DIGITS
+#    define SCRATCH_HEIGHT 105 // numbers/*.qgf are the tallest asset
+#else
+#    define SCRATCH_HEIGHT TUX_SIZE
+#endif
 
-#define LAYER_NAME_Y  8
-#define WPM_Y         42
-#define LOCK_Y        76
-#define TUX_X         17    // (135 - 100) / 2 = 17.5, rounded down
-#define TUX_Y         112   // Tight after locks, leaves 28px bottom padding
-#define IDLE_TIMEOUT  30000 // 30 seconds of no input → Game of Life
+static union {
+    uint8_t scratch[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(LCD_WIDTH, SCRATCH_HEIGHT, 16)];
+    struct {
+        uint8_t pixels[FB_STRIDE * LCD_HEIGHT];
+        uint16_t flush_buf[2][FLUSH_CHUNK_ROWS * LCD_WIDTH];
+    } live;
+} display_ram;
+
+static uint8_t *const fb = display_ram.live.pixels;
+
+// The last slot is never handed out: the layer name is drawn in it, and
+// layer transitions animate its color (see "Layer transition" below)
+#define PALETTE_FADE_SLOT (PALETTE_SIZE - 1)
+
+static uint16_t palette[PALETTE_SIZE]; // [0] stays black
+static uint8_t palette_count = 1;
+
+// Palette slot per layer, filled in by load_display_assets()
+static uint8_t layer_color_index[NUM_LAYERS];
+
+// Find or add a native color. Black, the 11 layer colors, the dim lock
+// color and Tux's two mid shades take all 15 shared slots; if another
+// color is ever added it falls back to black rather than stealing the
+// fade slot.
+static uint8_t palette_index(uint16_t native) {
+    for (uint8_t i = 0; i < palette_count; i++) {
+        if (palette[i] == native) return i;
+    }
+    if (palette_count == PALETTE_FADE_SLOT) return 0;
+
+    palette[palette_count] = native;
+    return palette_count++;
+}
+
+static inline void fb_set(uint16_t x, uint16_t y, uint8_t index) {
+    uint8_t *p = &fb[(uint32_t)y * FB_STRIDE + (x >> 1)];
+    *p = (x & 1) ? (*p & 0xF0) | index : (*p & 0x0F) | (index << 4);
+}
+
+static void fb_clear_rows(uint16_t top, uint16_t count) {
+    memset(&fb[(uint32_t)top * FB_STRIDE], 0, (uint32_t)count * FB_STRIDE);
+}
+
+// Inclusive bounds, clipped to the screen like qp_rect
+static void fb_fill_rect(uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, uint8_t index) {
+    if (right >= LCD_WIDTH) right = LCD_WIDTH - 1;
+    if (bottom >= LCD_HEIGHT) bottom = LCD_HEIGHT - 1;
+
+    for (uint16_t y = top; y <= bottom; y++) {
+        for (uint16_t x = left; x <= right; x++) {
+            fb_set(x, y, index);
+        }
+    }
+}
+
+// ==========================================================================
+// Dirty bands — only flush the rows that changed
+// ==========================================================================
+// Every draw function marks the rows it touched. Widgets are full-width
+// and stacked vertically, so full-width row bands are the natural unit: a
+// band is one qp_viewport + one contiguous run of rows out of the
+// framebuffer. A WPM tick sends ~30 rows (~8KB on the wire) instead of
+// the whole screen, and Game of Life only sends the rows with flipped cells.
+//
+// Bands that overlap or sit within DIRTY_MERGE_GAP rows of each other are
+// merged (a few extra rows are cheaper than another viewport command).
+// If the list fills up, the new band is folded into its nearest neighbour.
+
+#define DIRTY_BANDS_MAX  8
+#define DIRTY_MERGE_GAP  8
+
+typedef struct {
+    uint16_t top, bottom; // inclusive rows
+} dirty_band_t;
+
+static dirty_band_t dirty_bands[DIRTY_BANDS_MAX];
+static uint8_t dirty_band_count = 0;
+
+static void band_absorb(dirty_band_t *band, uint16_t top, uint16_t bottom) {
+    if (top < band->top) band->top = top;
+    if (bottom > band->bottom) band->bottom = bottom;
+}
+
+static bool bands_touch(const dirty_band_t *band, uint16_t top, uint16_t bottom) {
+    return top <= band->bottom + DIRTY_MERGE_GAP && bottom + DIRTY_MERGE_GAP >= band->top;
+}
+
+static void mark_dirty(uint16_t top, uint16_t bottom) {
+    if (bottom >= LCD_HEIGHT) bottom = LCD_HEIGHT - 1;
+
+    // Pull every band this one touches into it, then store the result.
+    // Absorbing can make it reach bands it didn't touch before, so rescan
+    // from the start after each merge.
+    bool merged = false;
+    uint8_t i   = 0;
+    while (i < dirty_band_count) {
+        if (bands_touch(&dirty_bands[i], top, bottom)) {
+            if (dirty_bands[i].top < top) top = dirty_bands[i].top;
+            if (dirty_bands[i].bottom > bottom) bottom = dirty_bands[i].bottom;
+            dirty_bands[i] = dirty_bands[--dirty_band_count];
+            merged = true;
+            i      = 0;
+        } else {
+            i++;
+        }
+    }
+    if (merged) {
+        dirty_bands[dirty_band_count++] = (dirty_band_t){top, bottom};
+        return;
+    }
+
+    if (dirty_band_count < DIRTY_BANDS_MAX) {
+        dirty_bands[dirty_band_count++] = (dirty_band_t){top, bottom};
+        return;
+    }
+
+    // Out of slots: merge into whichever band is closest
+    uint8_t  nearest = 0;
+    uint16_t best    = UINT16_MAX;
+    for (uint8_t i = 0; i < dirty_band_count; i++) {
+        uint16_t gap = (top > dirty_bands[i].bottom) ? top - dirty_bands[i].bottom
+                                                     : dirty_bands[i].top - bottom;
+        if (gap < best) {
+            best    = gap;
+            nearest = i;
+        }
+    }
+    band_absorb(&dirty_bands[nearest], top, bottom);
+}
+
+static void mark_all_dirty(void) {
+    dirty_bands[0]   = (dirty_band_t){0, LCD_HEIGHT - 1};
+    dirty_band_count = 1;
+}
+
+// ==========================================================================
+// Chunked flush — DMA moves the pixels, one chunk per tick
+// ==========================================================================
+// Each dirty band is one qp_viewport (a handful of command bytes, sent
+// synchronously) followed by the band's pixels. Those go out in chunks of
+// FLUSH_CHUNK_ROWS rows, one chunk per housekeeping tick: a chunk is
+// expanded through the palette into one of two small RGB565 buffers and
+// handed to spiStartSend(), which on the RP2040 is a DMA transfer, and the
+// tick returns while it is on the wire. The next chunk is expanded into
+// the other buffer straight away, so the palette expansion costs nothing
+// on top of the transfer.
+//
+// The following tick checks whether the DMA has finished. Until it has,
+// the display does nothing else; once it has, the bus is released with
+// spi_stop() and only then is the next chunk started. Other SPI users run
+// from the same scan loop and QMK's spi_start() fails rather than waits
+// when the bus is taken (cirque_pinnacle_spi then calls spi_stop() on the
+// way out, which would cut a transfer short), so the bus is held only
+// while a chunk is actually moving and never across a whole frame. The
+// ST7789 keeps writing RAM where it left off when CS comes back, the same
+// way Quantum Painter's own viewport / pixdata split relies on.
+//
+// While a frame is in flight nothing draws into the framebuffer (that would
+// tear the band being read), so new frames are coalesced: widgets notice
+// their changed state on the first tick after the flush finishes, and the
+// Game of Life just skips a step.
+
+static dirty_band_t flush_queue[DIRTY_BANDS_MAX];
+static uint8_t      flush_count     = 0;
+static uint8_t      flush_next      = 0;
+static bool         flush_band_open = false; // Viewport set for flush_next
+static bool         flush_in_flight = false; // DMA running, bus still ours
+static uint16_t     flush_row       = 0;     // Next row of the band to expand
+static uint8_t      flush_buf_sel   = 0;     // Buffer holding the expanded chunk
+static uint16_t     flush_buf_rows  = 0;     // Rows in it, 0 once the band is done
+
+static void expand_row(uint16_t y, uint16_t *out) {
+    const uint8_t *src = &fb[(uint32_t)y * FB_STRIDE];
+    for (uint16_t x = 0; x + 1 < LCD_WIDTH; x += 2) {
+        uint8_t pair = *src++;
+        *out++ = palette[pair >> 4];
+        *out++ = palette[pair & 0x0F];
+    }
+#if LCD_WIDTH & 1
+    *out = palette[*src >> 4];
+#endif
+}
+
+// Expand the band's next chunk into `out`, returns how many rows it holds
+static uint16_t expand_chunk(uint16_t *out) {
+    uint16_t bottom = flush_queue[flush_next].bottom;
+    uint16_t rows   = 0;
+    while (rows < FLUSH_CHUNK_ROWS && flush_row <= bottom) {
+        expand_row(flush_row++, out + rows * LCD_WIDTH);
+        rows++;
+    }
+    return rows;
+}
+
+static bool flush_start_band(void) {
+    uint16_t top    = flush_queue[flush_next].top;
+    uint16_t bottom = flush_queue[flush_next].bottom;
+
+    if (!qp_viewport(lcd, 0, top, LCD_WIDTH - 1, bottom)) {
+        return false; // Bus busy with someone else - try again next tick
+    }
+
+    flush_row       = top;
+    flush_buf_sel   = 0;
+    flush_buf_rows  = expand_chunk(display_ram.live.flush_buf[0]);
+    flush_band_open = true;
+    return true;
+}
+
+// Start the DMA for the expanded chunk and return without waiting for it.
+// Does nothing if the bus is taken - the same chunk goes next tick.
+static void flush_send_chunk(void) {
+    if (!spi_start(LCD_CS_PIN, false, LCD_SPI_MODE, LCD_SPI_DIVISOR)) {
+        return;
+    }
+    gpio_write_pin_high(LCD_DC_PIN); // data, not command
+
+    spiStartSend(&SPI_DRIVER, (size_t)flush_buf_rows * LCD_WIDTH * 2,
+                 display_ram.live.flush_buf[flush_buf_sel]);
+    flush_in_flight = true;
+
+    // Expand the next chunk while this one is on the wire
+    flush_buf_sel ^= 1;
+    flush_buf_rows = expand_chunk(display_ram.live.flush_buf[flush_buf_sel]);
+}
+
+// Advance the flush pipeline: finish the chunk on the wire, or start the
+// next one. Returns true while a frame is still going out (the
+// framebuffer must not be touched).
+static bool flush_busy(void) {
+    if (flush_in_flight) {
+        if (SPI_DRIVER.state != SPI_READY) {
+            return true; // Still sending - look again next tick
+        }
+        spi_stop();
+        flush_in_flight = false;
+
+        if (!flush_buf_rows) {
+            flush_band_open = false;
+            flush_next++;
+        }
+    }
+
+    if (flush_next >= flush_count) {
+        return false;
+    }
+    if (!flush_band_open && !flush_start_band()) {
+        return true;
+    }
+    flush_send_chunk();
+    return true;
+}
+
+// Hand the accumulated dirty bands to the pipeline
+static void flush_dirty_bands(void) {
+    if (!dirty_band_count) return;
+
+    memcpy(flush_queue, dirty_bands, sizeof(dirty_band_t) * dirty_band_count);
+    flush_count      = dirty_band_count;
+    flush_next       = 0;
+    flush_band_open  = false;
+    dirty_band_count = 0;
+    flush_busy();
+}
 
 // ==========================================================================
 // Game of Life — idle animation
@@ -111,227 +417,798 @@ static bool display_dirty = true; // Only flush surface to LCD when something ch
 #define GRID_HEIGHT 48
 #define CELL_SIZE   4
 #define OUTLINE_SIZE 1
-#define INITIAL_ALIVE_PROBABILITY 0.2
+// 20% of cells start alive. Integer threshold against a 32-bit random
+// draw (folded at compile time), so seeding needs no rand().
+#define INITIAL_ALIVE_THRESHOLD ((uint32_t)(0.2 * UINT32_MAX))
 
 static int color_value = 0;
 
-static bool grid[GRID_HEIGHT][GRID_WIDTH];
-static bool new_grid[GRID_HEIGHT][GRID_WIDTH];
-static bool changed_grid[GRID_HEIGHT][GRID_WIDTH];
+// One uint32_t per row, bit x = column x (27 columns fit in a word). Two
+// generations are kept and swapped by pointer; changed_rows holds the
+// cells that flipped in the last step (old ^ new), which is all draw_grid
+// needs to repaint. ~580 bytes instead of three 27×48 bool arrays.
+#define ROW_MASK ((1UL << GRID_WIDTH) - 1)
 
-static uint32_t get_random_32bit(void) {
-    uint32_t random_value = 0;
-    for (int i = 0; i < 32; i++) {
-        wait_ms(1);
-        random_value = (random_value << 1) | (rosc_hw->randombit & 1);
-    }
-    return random_value;
+_Static_assert(GRID_WIDTH <= 32, "Game of Life rows are one uint32_t each");
+
+static uint32_t gol_rows[2][GRID_HEIGHT];
+static uint32_t *grid = gol_rows[0];
+static uint32_t *new_grid = gol_rows[1];
+static uint32_t changed_rows[GRID_HEIGHT];
+
+// A row can only change next generation if it or a neighbour changed in
+// this one, so update_grid() only steps the rows in gol_active (bit y =
+// row y) and copies the rest. A settled board costs 48 bit tests.
+//
+// Settling is caught by hashing each generation: no changed rows is a
+// still life, a hash equal to two or three generations back is a
+// period-2/3 oscillator (blinkers, toads, beacons, pulsar-ish debris).
+// Once settled there's nothing new to watch, so a fresh cluster goes in
+// after GOL_RESEED_MS instead of waiting out the 5s color cycle. A hash
+// collision would only cause one early reseed.
+#define GOL_ACTIVE_ALL  ((1ULL << GRID_HEIGHT) - 1)
+#define GOL_RESEED_MS   1000
+
+_Static_assert(GRID_HEIGHT <= 64, "Game of Life active rows are one uint64_t");
+
+static uint64_t gol_active = GOL_ACTIVE_ALL;
+static uint32_t gol_history[3];  // Hashes of generations t-1, t-2, t-3
+static uint8_t gol_period = 0;   // 0 while evolving, else 1/2/3
+static uint32_t gol_settled_at = 0;
+
+// ==========================================================================
+// Entropy — never blocks the scan loop
+// ==========================================================================
+// The RP2040 ring oscillator's randombit is the only real entropy on the
+// board, but reading it back-to-back gives correlated bits (it needs time
+// to drift between samples). Rather than wait_ms() between reads, one bit
+// is folded into a pool per housekeeping tick. By the time the
+// keyboard has sat idle for 30s the pool has seen tens of thousands of
+// samples, and seeding Game of Life is just a read.
+//
+// Game of Life itself runs off xorshift32: fast, tiny, and plenty random
+// for picking which pixels start alive.
+
+static uint32_t entropy_pool = 0;
+static uint32_t prng_state = 1; // xorshift32 must never be 0
+
+static void entropy_harvest(void) {
+    // Rotate-and-xor so old bits keep mixing instead of falling off
+    entropy_pool = ((entropy_pool << 1) | (entropy_pool >> 31)) ^
+                   (rosc_hw->randombit & 1);
+}
+
+static void prng_seed(uint32_t seed) {
+    prng_state = seed ? seed : 0x9E3779B9;
+}
+
+static uint32_t prng_next(void) {
+    uint32_t x = prng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    prng_state = x;
+    return x;
 }
 
 static void init_grid(void) {
     for (int y = 0; y < GRID_HEIGHT; y++) {
+        uint32_t row = 0;
         for (int x = 0; x < GRID_WIDTH; x++) {
-            grid[y][x] = (rand() < INITIAL_ALIVE_PROBABILITY * RAND_MAX);
-            changed_grid[y][x] = true;
+            if (prng_next() < INITIAL_ALIVE_THRESHOLD) {
+                row |= 1UL << x;
+            }
         }
+        grid[y] = row;
+        changed_rows[y] = ROW_MASK;
     }
+    gol_active = GOL_ACTIVE_ALL;
+    gol_period = 0;
 }
 
 static void draw_grid(void) {
+    uint8_t color = layer_color_index[color_value % NUM_LAYERS];
+
     for (int y = 0; y < GRID_HEIGHT; y++) {
+        uint32_t changed = changed_rows[y];
+        if (!changed) continue; // Most rows of a settled board are static
+
+        uint16_t row_top = y * (CELL_SIZE + OUTLINE_SIZE);
+        mark_dirty(row_top, row_top + CELL_SIZE + OUTLINE_SIZE);
+
         for (int x = 0; x < GRID_WIDTH; x++) {
-            if (changed_grid[y][x]) {
+            if (changed & (1UL << x)) {
                 uint16_t left   = x * (CELL_SIZE + OUTLINE_SIZE);
                 uint16_t top    = y * (CELL_SIZE + OUTLINE_SIZE);
                 uint16_t right  = left + CELL_SIZE + OUTLINE_SIZE;
                 uint16_t bottom = top + CELL_SIZE + OUTLINE_SIZE;
 
                 // Black outline
-                qp_rect(lcd_surface, left, top, right, bottom, 0, 0, 0, true);
+                fb_fill_rect(left, top, right, bottom, 0);
 
                 // Alive cells get the current cyberpunk color
-                if (grid[y][x]) {
-                    display_hsv_t c = layer_colors[color_value % NUM_LAYERS];
-                    qp_rect(lcd_surface, left + OUTLINE_SIZE, top + OUTLINE_SIZE,
-                            right - OUTLINE_SIZE, bottom - OUTLINE_SIZE,
-                            c.h, c.s, c.v, true);
+                if (grid[y] & (1UL << x)) {
+                    fb_fill_rect(left + OUTLINE_SIZE, top + OUTLINE_SIZE,
+                                 right - OUTLINE_SIZE, bottom - OUTLINE_SIZE, color);
                 }
             }
         }
     }
 }
 
-static void update_grid(void) {
+// Bit-sliced adders: each bit position is an independent cell, so one
+// call adds 27 columns at once. sum = weight-1 bit, carry = weight-2 bit.
+static inline void full_add(uint32_t a, uint32_t b, uint32_t c,
+                            uint32_t *sum, uint32_t *carry) {
+    uint32_t t = a ^ b;
+    *sum   = t ^ c;
+    *carry = (a & b) | (t & c);
+}
+
+// Next generation of a whole row from the rows above/below. Cells outside
+// the board count as dead, same as the old bounds-checked loop.
+static uint32_t step_row(uint32_t up, uint32_t mid, uint32_t down) {
+    // Three neighbours from each of the rows above and below, two from
+    // our own row (not the cell itself)
+    uint32_t u0, u1, d0, d1;
+    full_add(up << 1, up, up >> 1, &u0, &u1);
+    full_add(down << 1, down, down >> 1, &d0, &d1);
+    uint32_t m0 = (mid << 1) ^ (mid >> 1);
+    uint32_t m1 = (mid << 1) & (mid >> 1);
+
+    // Combine into a 3-bit count per cell (s2 s1 s0). A count of 8 wraps
+    // to 0, which is fine - it dies either way.
+    uint32_t s0, c1, t0, t1;
+    full_add(u0, d0, m0, &s0, &c1);  // ones → s0, carry into twos
+    full_add(u1, d1, m1, &t0, &t1);  // twos → t0, carry into fours
+    uint32_t s1 = t0 ^ c1;
+    uint32_t s2 = t1 ^ (t0 & c1);
+
+    // Alive next if count == 3, or count == 2 and alive now
+    return s1 & ~s2 & (s0 | mid) & ROW_MASK;
+}
+
+// FNV-1a over the row words - only compared against itself
+static uint32_t grid_hash(const uint32_t *rows) {
+    uint32_t hash = 2166136261u;
     for (int y = 0; y < GRID_HEIGHT; y++) {
-        for (int x = 0; x < GRID_WIDTH; x++) {
-            int alive_neighbors = 0;
-            for (int dy = -1; dy <= 1; dy++) {
-                for (int dx = -1; dx <= 1; dx++) {
-                    if (dy == 0 && dx == 0) continue;
-                    int ny = y + dy;
-                    int nx = x + dx;
-                    if (ny >= 0 && ny < GRID_HEIGHT && nx >= 0 && nx < GRID_WIDTH) {
-                        alive_neighbors += grid[ny][nx];
-                    }
-                }
-            }
-            if (grid[y][x]) {
-                new_grid[y][x] = (alive_neighbors == 2 || alive_neighbors == 3);
-            } else {
-                new_grid[y][x] = (alive_neighbors == 3);
-            }
-            changed_grid[y][x] = (grid[y][x] != new_grid[y][x]);
-        }
+        hash = (hash ^ rows[y]) * 16777619u;
     }
+    return hash;
+}
+
+static void update_grid(void) {
+    uint64_t next_active = 0;
+
     for (int y = 0; y < GRID_HEIGHT; y++) {
-        for (int x = 0; x < GRID_WIDTH; x++) {
-            grid[y][x] = new_grid[y][x];
+        if (!((gol_active >> y) & 1)) {
+            new_grid[y] = grid[y];
+            changed_rows[y] = 0;
+            continue;
         }
+
+        uint32_t up   = (y > 0) ? grid[y - 1] : 0;
+        uint32_t down = (y < GRID_HEIGHT - 1) ? grid[y + 1] : 0;
+        new_grid[y] = step_row(up, grid[y], down);
+        changed_rows[y] = grid[y] ^ new_grid[y];
+
+        if (changed_rows[y]) {
+            next_active |= (7ULL << y) >> 1; // Rows y-1, y, y+1
+        }
+    }
+
+    uint32_t *old = grid;
+    grid = new_grid;
+    new_grid = old;
+    gol_active = next_active & GOL_ACTIVE_ALL;
+
+    uint32_t hash = grid_hash(grid);
+    uint8_t period = !gol_active                ? 1
+                   : (hash == gol_history[1])   ? 2
+                   : (hash == gol_history[2])   ? 3
+                                                : 0;
+    if (period && !gol_period) {
+        gol_settled_at = timer_read32();
     }
+    gol_period = period;
+
+    gol_history[2] = gol_history[1];
+    gol_history[1] = gol_history[0];
+    gol_history[0] = hash;
 }
 
 static void add_cell_cluster(void) {
     int cluster_size = 3;
-    int x = rand() % (GRID_WIDTH - cluster_size);
-    int y = rand() % (GRID_HEIGHT - cluster_size);
+    int x = prng_next() % (GRID_WIDTH - cluster_size);
+    int y = prng_next() % (GRID_HEIGHT - cluster_size);
     for (int dy = 0; dy < cluster_size; dy++) {
-        for (int dx = 0; dx < cluster_size; dx++) {
-            grid[y + dy][x + dx] = rand() % 2;
-            changed_grid[y + dy][x + dx] = true;
+        uint32_t cells = (prng_next() & 0x7) << x;
+        uint32_t span  = 0x7UL << x;
+        grid[y + dy] = (grid[y + dy] & ~span) | cells;
+        changed_rows[y + dy] |= span;
+    }
+
+    // Wake the cluster rows and their neighbours
+    gol_active |= ((1ULL << (cluster_size + 2)) - 1) << y >> 1;
+    gol_active &= GOL_ACTIVE_ALL;
+    gol_period = 0;
+}
+
+// ==========================================================================
+// Glyph atlas — pre-rendered text for the info widgets
+// ==========================================================================
+// Everything the info screen ever writes is known up front: the digits and
+// " wpm", the layer names, and C/N/S in both fonts. So at boot each of
+// those strings is rendered onto the scratch surface, read back as a 1bpp
+// mask, and packed into atlas_pool. Retron2000 is a mono2 font, so the
+// mask loses nothing.
+//
+// At runtime a widget update is then a memset of its rows plus a mask →
+// palette index blit straight into the framebuffer: no snprintf, no QFF
+// glyph decode, no per-glyph recolor. Colors are resolved once too, by
+// drawing one pixel and adding the native RGB565 value the surface wrote
+// to the palette.
+//
+// A string that doesn't fit the pool keeps width 0 and just isn't drawn.
+
+// Retron2000-27 is monospace, 18px wide on a 30px line: the 28 strings
+// above come to ~5.3KB of masks
+#define ATLAS_POOL_BYTES 6144
+
+typedef struct {
+    uint16_t offset; // Into atlas_pool
+    uint8_t width;   // Pixels; rows are (width + 7) / 8 bytes
+} atlas_glyph_t;
+
+static uint8_t atlas_pool[ATLAS_POOL_BYTES];
+static uint16_t atlas_used = 0;
+static uint8_t atlas_height = 0;
+
+static atlas_glyph_t atlas_digits[10];
+static atlas_glyph_t atlas_wpm_suffix;
+static atlas_glyph_t atlas_layers[NUM_LAYERS];
+static atlas_glyph_t atlas_locks[3][2]; // [label][active]
+
+static uint8_t wpm_color_index, lock_on_color_index, lock_off_color_index;
+
+static inline const uint8_t *scratch_pixel(uint16_t x, uint16_t y) {
+    return &display_ram.scratch[((uint32_t)y * LCD_WIDTH + x) * 2];
+}
+
+static inline uint16_t scratch_native(uint16_t x, uint16_t y) {
+    const uint8_t *p = scratch_pixel(x, y);
+    return p[0] | (p[1] << 8);
+}
+
+static uint16_t native_color(uint8_t h, uint8_t s, uint8_t v) {
+    qp_setpixel(lcd_surface, 0, 0, h, s, v);
+    return scratch_native(0, 0);
+}
+
+static uint8_t color_index(uint8_t h, uint8_t s, uint8_t v) {
+    return palette_index(native_color(h, s, v));
+}
+
+static void atlas_capture(atlas_glyph_t *g, painter_font_handle_t f, const char *text) {
+    int16_t w = qp_textwidth(f, text);
+    uint16_t stride = (w + 7) / 8;
+    uint16_t bytes = stride * atlas_height;
+    if (w <= 0 || w > LCD_WIDTH || atlas_used + bytes > ATLAS_POOL_BYTES) {
+        return;
+    }
+
+    qp_rect(lcd_surface, 0, 0, w - 1, atlas_height - 1, 0, 0, 0, true);
+    qp_drawtext_recolor(lcd_surface, 0, 0, f, text, 0, 0, 255, 0, 0, 0);
+
+    uint8_t *mask = &atlas_pool[atlas_used];
+    memset(mask, 0, bytes);
+    for (uint8_t y = 0; y < atlas_height; y++) {
+        for (int16_t x = 0; x < w; x++) {
+            if (scratch_native(x, y)) {
+                mask[y * stride + (x >> 3)] |= 0x80 >> (x & 7);
+            }
         }
     }
+
+    g->offset = atlas_used;
+    g->width = w;
+    atlas_used += bytes;
+}
+
+static void atlas_build(painter_font_handle_t font, painter_font_handle_t font_underline) {
+    char digit[2] = {0, 0};
+
+    atlas_height = font->line_height;
+
+    for (uint8_t i = 0; i < 10; i++) {
+        digit[0] = '0' + i;
+        atlas_capture(&atlas_digits[i], font, digit);
+    }
+    atlas_capture(&atlas_wpm_suffix, font, " wpm");
+
+    for (uint8_t i = 0; i < NUM_LAYERS; i++) {
+        atlas_capture(&atlas_layers[i], font, layer_names[i]);
+    }
+
+    for (uint8_t i = 0; i < 3; i++) {
+        atlas_capture(&atlas_locks[i][0], font, lock_labels[i]);
+        atlas_capture(&atlas_locks[i][1], font_underline, lock_labels[i]);
+    }
+}
+
+// Clear the full-width rows a text widget occupies
+static void atlas_clear_rows(uint16_t y) {
+    fb_clear_rows(y, atlas_height + 1);
 }
 
+// Draw a 1bpp mask's set pixels as palette `index` (rows are (w + 7) / 8 bytes)
+static void mask_blit(const uint8_t *mask, uint8_t w, uint8_t h, int16_t x, uint16_t y, uint8_t index) {
+    if (x < 0 || x + w > LCD_WIDTH) return;
+
+    uint16_t stride = (w + 7) / 8;
+
+    for (uint8_t row = 0; row < h; row++, mask += stride) {
+        for (uint8_t col = 0; col < w; col++) {
+            if (mask[col >> 3] & (0x80 >> (col & 7))) {
+                fb_set(x + col, y + row, index);
+            }
+        }
+    }
+}
+
+// Draw one atlas glyph, returns the x after it
+static int16_t atlas_blit(const atlas_glyph_t *g, int16_t x, uint16_t y, uint8_t index) {
+    mask_blit(&atlas_pool[g->offset], g->width, atlas_height, x, y, index);
+    return x + g->width;
+}
+
+#ifdef HLC_WPM_BIG_DIGITS
+// ==========================================================================
+// Big-digit WPM gauge (HLC_WPM_BIG_DIGITS)
+// ==========================================================================
+// The numbers/ images are 75×105, so three of them side by side would be
+// 225px wide on a 135px screen. Instead each one is drawn once onto the
+// scratch surface, read back at half size and kept as a 38×53 1bpp mask. A target
+// pixel is lit if any of its 2×2 source pixels is, so thin strokes
+// survive. The gauge takes Tux's spot. A WPM change only re-blits the
+// digit slots whose value actually changed, and leading zeros are left
+// blank.
+
+#define BIG_SRC_W    75
+#define BIG_SRC_H    105
+#define BIG_W        ((BIG_SRC_W + 1) / 2)
+#define BIG_H        ((BIG_SRC_H + 1) / 2)
+#define BIG_STRIDE   ((BIG_W + 7) / 8)
+#define BIG_GAP      4
+#define BIG_X        ((LCD_WIDTH - (3 * BIG_W + 2 * BIG_GAP)) / 2)
+#define BIG_Y        (TUX_Y + (TUX_SIZE - BIG_H) / 2)
+#define BIG_BLANK    10   // Slot shows nothing (leading zero)
+#define BIG_UNKNOWN  0xFF // Slot contents unknown, always redraw
+
+static const uint8_t *const big_digit_images[10] = {
+    gfx_0, gfx_1, gfx_2, gfx_3, gfx_4, gfx_5, gfx_6, gfx_7, gfx_8, gfx_9,
+};
+
+static uint8_t big_digits[10][BIG_STRIDE * BIG_H];
+static uint8_t big_shown[3] = { BIG_UNKNOWN, BIG_UNKNOWN, BIG_UNKNOWN };
+static bool big_ready = false;
+
+static void big_digits_build(void) {
+    for (uint8_t i = 0; i < 10; i++) {
+        painter_image_handle_t img = qp_load_image_mem(big_digit_images[i]);
+        if (img == NULL) {
+            return; // big_ready stays false, the gauge falls back to text
+        }
+
+        qp_rect(lcd_surface, 0, 0, BIG_SRC_W - 1, BIG_SRC_H - 1, 0, 0, 0, true);
+        qp_drawimage_recolor(lcd_surface, 0, 0, img, 0, 0, 255, 0, 0, 0);
+        qp_close_image(img);
+
+        uint8_t *mask = big_digits[i];
+        memset(mask, 0, sizeof(big_digits[i]));
+        for (uint8_t y = 0; y < BIG_SRC_H; y++) {
+            for (uint8_t x = 0; x < BIG_SRC_W; x++) {
+                if (scratch_native(x, y)) {
+                    mask[(y / 2) * BIG_STRIDE + (x / 2) / 8] |= 0x80 >> ((x / 2) & 7);
+                }
+            }
+        }
+    }
+
+    big_ready = true;
+}
+#endif
+
 // ==========================================================================
 // Info display — layer name, WPM, locks, Tux
 // ==========================================================================
-// Each draw function only redraws when its state changes, except on
-// force=true (used when waking from idle mode to repaint everything).
+// Draw functions draw unconditionally; whether they need to run is decided
+// by the matching *_pending() check, which the scheduler below calls first.
+
+// ---- Layer transition ----
+// A layer change dims the old name to black over the first half of
+// LAYER_FADE_MS, swaps in the new name, and brings it up to full color
+// over the second half. The name is always drawn in PALETTE_FADE_SLOT, so
+// a fade frame is just rewriting one palette entry from a LUT and marking
+// the name rows dirty - no pixel drawing apart from the one glyph swap.
+//
+// The LUTs are built at boot (layer_fade[layer][step], the layer's color
+// at (step + 1) / LAYER_FADE_STEPS of its brightness), and each frame
+// picks its step from the elapsed time, so frames skipped while the
+// scheduler is out of budget or a flush is in flight don't slow the
+// animation down, they just drop steps.
+
+#define LAYER_FADE_MS     200
+#define LAYER_FADE_STEPS  8
+#define LAYER_FADE_FRAME  16 // ms between frames, ~60fps cap
+#define LAYER_NONE        0xFF
+
+static uint16_t layer_fade[NUM_LAYERS][LAYER_FADE_STEPS];
+
+static uint8_t shown_layer = LAYER_NONE; // Whose name is in the framebuffer
+static uint8_t fade_from = LAYER_NONE;
+static uint8_t fade_to = LAYER_NONE;
+static uint16_t fade_start = 0;
+static bool fade_active = false;
+
+static void build_layer_fades(void) {
+    for (uint8_t i = 0; i < NUM_LAYERS; i++) {
+        for (uint8_t step = 0; step < LAYER_FADE_STEPS; step++) {
+            uint8_t v = (uint16_t)layer_colors[i].v * (step + 1) / LAYER_FADE_STEPS;
+            layer_fade[i][step] = native_color(layer_colors[i].h, layer_colors[i].s, v);
+        }
+    }
+}
 
-static void draw_layer_name(bool force) {
-    if (last_layer != layer_state || force) {
-        // Clear just the text area (full width to handle variable-length names)
-        qp_rect(lcd_surface, 0, LAYER_NAME_Y, LCD_WIDTH - 1, LAYER_NAME_Y + font->line_height, 0, 0, 0, true);
+static void set_fade_color(uint8_t layer, uint8_t step) {
+    palette[PALETTE_FADE_SLOT] = (layer < NUM_LAYERS) ? layer_fade[layer][step] : 0;
+}
+
+static bool layer_name_pending(void) {
+    return last_layer != layer_state;
+}
 
-        uint8_t layer = get_highest_layer(layer_state | default_layer_state);
-        const char *name = (layer < NUM_LAYERS) ? layer_names[layer] : "???";
-        display_hsv_t c = (layer < NUM_LAYERS)
-            ? layer_colors[layer]
-            : (display_hsv_t){0, 255, 255};
+// Layer changed: just (re)start the transition, the fade widget draws it
+static void draw_layer_name(void) {
+    uint8_t layer = get_highest_layer(layer_state | default_layer_state);
+    last_layer = layer_state;
 
-        // Center the text horizontally
-        int16_t text_w = qp_textwidth(font, name);
-        int16_t text_x = (LCD_WIDTH - text_w) / 2;
-        qp_drawtext_recolor(lcd_surface, text_x, LAYER_NAME_Y, font, name,
-                            c.h, c.s, c.v, 0, 0, 0);
+    // A lower layer toggled under the same top layer, or we're already
+    // heading there - nothing new to show
+    if (fade_active ? layer == fade_to : layer == shown_layer) return;
 
-        last_layer = layer_state;
-        display_dirty = true;
+    fade_to = layer;
+    fade_from = shown_layer;
+    fade_start = timer_read();
+    fade_active = true;
+}
+
+static bool layer_fade_pending(void) {
+    return fade_active;
+}
+
+static void draw_layer_fade(void) {
+    uint16_t elapsed = timer_elapsed(fade_start);
+    uint16_t half = LAYER_FADE_MS / 2;
+
+    if (elapsed < half && fade_from != fade_to && fade_from != LAYER_NONE) {
+        // Fading out the old name
+        set_fade_color(fade_from, LAYER_FADE_STEPS - 1 - (uint32_t)elapsed * LAYER_FADE_STEPS / half);
+    } else {
+        if (shown_layer != fade_to) {
+            // Clear just the text area (full width to handle variable-length names)
+            atlas_clear_rows(LAYER_NAME_Y);
+            if (fade_to < NUM_LAYERS) {
+                const atlas_glyph_t *g = &atlas_layers[fade_to];
+                atlas_blit(g, (LCD_WIDTH - g->width) / 2, LAYER_NAME_Y, PALETTE_FADE_SLOT);
+            }
+            shown_layer = fade_to;
+        }
+
+        if (elapsed >= LAYER_FADE_MS) {
+            set_fade_color(fade_to, LAYER_FADE_STEPS - 1);
+            fade_active = false;
+        } else {
+            uint16_t in = (elapsed > half) ? elapsed - half : 0;
+            set_fade_color(fade_to, (uint32_t)in * LAYER_FADE_STEPS / half);
+        }
     }
+
+    mark_dirty(LAYER_NAME_Y, LAYER_NAME_Y + atlas_height);
 }
 
-static void draw_wpm(bool force) {
+static bool wpm_pending(void) {
 #ifdef WPM_ENABLE
-    uint8_t current_wpm = get_current_wpm();
-    if (current_wpm != last_wpm || force) {
-        // Clear just the WPM text area
-        qp_rect(lcd_surface, 0, WPM_Y, LCD_WIDTH - 1, WPM_Y + font->line_height, 0, 0, 0, true);
+    return get_current_wpm() != last_wpm;
+#else
+    return false;
+#endif
+}
 
-        char wpm_str[12];
-        snprintf(wpm_str, sizeof(wpm_str), "%d wpm", current_wpm);
+static void draw_wpm(void) {
+#ifdef WPM_ENABLE
+    uint8_t current_wpm = get_current_wpm();
 
-        int16_t text_w = qp_textwidth(font, wpm_str);
-        int16_t text_x = (LCD_WIDTH - text_w) / 2;
-        qp_drawtext_recolor(lcd_surface, text_x, WPM_Y, font, wpm_str,
-                            HSV_WPM, 0, 0, 0);
+    // Split into digits without leading zeros (0-255, so at most 3)
+    uint8_t digits[3];
+    uint8_t count = 0;
+    uint8_t n = current_wpm;
+    do {
+        digits[count++] = n % 10;
+        n /= 10;
+    } while (n);
+
+    int16_t text_w = atlas_wpm_suffix.width;
+    for (uint8_t i = 0; i < count; i++) {
+        text_w += atlas_digits[digits[i]].width;
+    }
 
-        last_wpm = current_wpm;
-        display_dirty = true;
+    // Clear just the WPM text area, then "XXX wpm" centered
+    atlas_clear_rows(WPM_Y);
+    int16_t x = (LCD_WIDTH - text_w) / 2;
+    while (count) {
+        x = atlas_blit(&atlas_digits[digits[--count]], x, WPM_Y, wpm_color_index);
     }
+    atlas_blit(&atlas_wpm_suffix, x, WPM_Y, wpm_color_index);
+
+    last_wpm = current_wpm;
+    mark_dirty(WPM_Y, WPM_Y + atlas_height);
 #endif
 }
 
-static void draw_locks(bool force) {
+static bool locks_pending(void) {
+    return host_keyboard_led_state().raw != last_led_state.raw;
+}
+
+static void draw_locks(void) {
     led_t current = host_keyboard_led_state();
-    if (current.raw != last_led_state.raw || force) {
-        // Clear just the lock text area
-        qp_rect(lcd_surface, 0, LOCK_Y, LCD_WIDTH - 1, LOCK_Y + font->line_height, 0, 0, 0, true);
-
-        // Three lock states mapped to the three labels
-        bool lock_active[] = { current.caps_lock, current.num_lock, current.scroll_lock };
-
-        // Spread evenly across the display width (thirds)
-        int16_t third = LCD_WIDTH / 3;
-
-        for (int i = 0; i < 3; i++) {
-            painter_font_handle_t f = lock_active[i] ? font_underline : font;
-            int16_t tw = qp_textwidth(f, lock_labels[i]);
-            int16_t tx = (third * i) + (third - tw) / 2;
-
-            if (lock_active[i]) {
-                qp_drawtext_recolor(lcd_surface, tx, LOCK_Y, f, lock_labels[i],
-                                    HSV_LOCK_ON, 0, 0, 0);
-            } else {
-                qp_drawtext_recolor(lcd_surface, tx, LOCK_Y, f, lock_labels[i],
-                                    HSV_LOCK_OFF, 0, 0, 0);
-            }
+
+    // Three lock states mapped to the three labels
+    bool lock_active[] = { current.caps_lock, current.num_lock, current.scroll_lock };
+
+    // Spread evenly across the display width (thirds)
+    int16_t third = LCD_WIDTH / 3;
+
+    // Clear just the lock text area
+    atlas_clear_rows(LOCK_Y);
+
+    for (int i = 0; i < 3; i++) {
+        // Active locks use the underlined font
+        const atlas_glyph_t *g = &atlas_locks[i][lock_active[i]];
+        atlas_blit(g, (third * i) + (third - g->width) / 2, LOCK_Y,
+                   lock_active[i] ? lock_on_color_index : lock_off_color_index);
+    }
+
+    last_led_state = current;
+    mark_dirty(LOCK_Y, LOCK_Y + atlas_height);
+}
+
+#ifdef HLC_WPM_BIG_DIGITS
+static void draw_wpm_big(void) {
+    if (!big_ready) {
+        draw_wpm(); // Digits failed to load, plain text instead
+        return;
+    }
+
+#    ifdef WPM_ENABLE
+    uint8_t current_wpm = get_current_wpm();
+    uint8_t want[3] = { current_wpm / 100, (current_wpm / 10) % 10, current_wpm % 10 };
+    if (current_wpm < 100) want[0] = BIG_BLANK;
+    if (current_wpm < 10) want[1] = BIG_BLANK;
+
+    bool changed = false;
+    for (uint8_t slot = 0; slot < 3; slot++) {
+        if (want[slot] == big_shown[slot]) continue;
+
+        int16_t x = BIG_X + slot * (BIG_W + BIG_GAP);
+        fb_fill_rect(x, BIG_Y, x + BIG_W - 1, BIG_Y + BIG_H - 1, 0);
+        if (want[slot] != BIG_BLANK) {
+            mask_blit(big_digits[want[slot]], BIG_W, BIG_H, x, BIG_Y, wpm_color_index);
         }
+        big_shown[slot] = want[slot];
+        changed = true;
+    }
 
-        last_led_state = current;
-        display_dirty = true;
+    last_wpm = current_wpm;
+    if (changed) {
+        mark_dirty(BIG_Y, BIG_Y + BIG_H - 1);
+    }
+#    endif
+}
+#else
+// Tux as palette indices, 4bpp like the framebuffer (~5KB). Rendered once
+// at boot; drawing it is then a copy, which matters because every wake
+// from idle repaints it.
+static uint8_t tux_pixels[TUX_SIZE * TUX_SIZE / 2];
+
+static void tux_capture(void) {
+    // The image data lives in flash (gfx_tux_100), we only need the
+    // handle briefly to draw it once.
+    painter_image_handle_t tux_img = qp_load_image_mem(gfx_tux_100);
+    if (tux_img == NULL) return;
+
+    qp_rect(lcd_surface, 0, 0, TUX_SIZE - 1, TUX_SIZE - 1, 0, 0, 0, true);
+    qp_drawimage_recolor(lcd_surface, 0, 0, tux_img,
+                         HSV_TUX_FG,   // Light pixels → Cyan
+                         HSV_TUX_BG);  // Dark pixels  → Magenta
+    qp_close_image(tux_img);
+
+    // Four grayscale shades → four palette entries
+    for (uint16_t y = 0; y < TUX_SIZE; y++) {
+        for (uint16_t x = 0; x < TUX_SIZE; x++) {
+            uint8_t index = palette_index(scratch_native(x, y));
+            tux_pixels[(y * TUX_SIZE + x) / 2] |= (x & 1) ? index : index << 4;
+        }
     }
 }
 
+static bool tux_pending(void) {
+    return !tux_drawn;
+}
+
 static void draw_tux(void) {
-    if (!tux_drawn) {
-        // Load → draw → close. The image data lives in flash (gfx_tux_100),
-        // we only need the handle briefly to draw it once.
-        painter_image_handle_t tux_img = qp_load_image_mem(gfx_tux_100);
-        qp_drawimage_recolor(lcd_surface, TUX_X, TUX_Y, tux_img,
-                             HSV_TUX_FG,   // Light pixels → Cyan
-                             HSV_TUX_BG);  // Dark pixels  → Magenta
-        qp_close_image(tux_img);
-        tux_drawn = true;
-        display_dirty = true;
+    for (uint16_t y = 0; y < TUX_SIZE; y++) {
+        for (uint16_t x = 0; x < TUX_SIZE; x++) {
+            uint8_t pair = tux_pixels[(y * TUX_SIZE + x) / 2];
+            fb_set(TUX_X + x, TUX_Y + y, (x & 1) ? pair & 0x0F : pair >> 4);
+        }
     }
+    tux_drawn = true;
+    mark_dirty(TUX_Y, TUX_Y + TUX_SIZE - 1);
 }
+#endif
 
-// Full redraw — called when waking from idle mode
-static void force_redraw_info(void) {
-    // Ensure fonts are loaded (may not be if we went idle before first active draw)
-    if (!fonts_loaded) {
-        font = qp_load_font_mem(font_Retron2000_27);
-        font_underline = qp_load_font_mem(font_Retron2000_underline_27);
-        fonts_loaded = true;
+// Rasterise everything the widgets draw, through the scratch surface.
+// Runs once from module_post_init_kb, before display_ram becomes the
+// framebuffer.
+static void load_display_assets(void) {
+    painter_font_handle_t font = qp_load_font_mem(font_Retron2000_27);
+    painter_font_handle_t font_underline = qp_load_font_mem(font_Retron2000_underline_27);
+    if (font != NULL && font_underline != NULL) {
+        atlas_build(font, font_underline);
+    }
+    qp_close_font(font);
+    qp_close_font(font_underline);
+
+    for (uint8_t i = 0; i < NUM_LAYERS; i++) {
+        layer_color_index[i] = color_index(layer_colors[i].h, layer_colors[i].s, layer_colors[i].v);
+    }
+    wpm_color_index      = color_index(HSV_WPM);
+    lock_on_color_index  = color_index(HSV_LOCK_ON);
+    lock_off_color_index = color_index(HSV_LOCK_OFF);
+    build_layer_fades();
+
+#ifdef HLC_WPM_BIG_DIGITS
+    big_digits_build();
+#else
+    tux_capture();
+#endif
+}
+
+// Game of Life frame — the only idle-mode widget
+static bool gol_pending(void) {
+    return true; // Rate-limited by its interval alone
+}
+
+static void draw_gol_frame(void) {
+    draw_grid();
+    update_grid();
+
+    // Settled into a still life or short oscillator: reseed early
+    if (gol_period && timer_elapsed32(gol_settled_at) >= GOL_RESEED_MS) {
+        add_cell_cluster();
     }
 
-    qp_rect(lcd_surface, 0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1, 0, 0, 0, true);
+    // Slowly cycle colors every 5 seconds while idle
+    static uint32_t last_color_change = 0;
+    if (timer_elapsed32(last_color_change) >= 5000) {
+        color_value = (color_value + 1) % NUM_LAYERS;
+        add_cell_cluster();
+        last_color_change = timer_read32();
+    }
+}
+
+// Full redraw — called when waking from idle mode. This only clears the
+// screen and invalidates the cached state; the scheduler then repaints the
+// widgets over the next few ticks, so the keypress that woke us isn't
+// stuck behind a whole-screen render.
+static void force_redraw_info(void) {
+    fb_clear_rows(0, LCD_HEIGHT);
 
-    // Invalidate all cached state so every draw function runs
+    // Invalidate all cached state so every widget is pending
     last_layer = ~layer_state;
+    shown_layer = LAYER_NONE; // Fade the name in from black
+    fade_active = false;
     last_wpm = 255;
     last_led_state.raw = ~host_keyboard_led_state().raw;
     tux_drawn = false;
+#ifdef HLC_WPM_BIG_DIGITS
+    memset(big_shown, BIG_UNKNOWN, sizeof(big_shown));
+#endif
 
-    draw_layer_name(true);
-    draw_wpm(true);
-    draw_locks(true);
-    draw_tux();
-    display_dirty = true;
+    mark_all_dirty();
 }
 
-// Incremental update — only redraws changed elements
-static void update_info_display(void) {
-    if (!fonts_loaded) {
-        font = qp_load_font_mem(font_Retron2000_27);
-        font_underline = qp_load_font_mem(font_Retron2000_underline_27);
-        fonts_loaded = true;
+// ==========================================================================
+// Widget scheduler — bounded display work per housekeeping tick
+// ==========================================================================
+// Each widget declares how often it may redraw (interval_ms, 0 = as soon
+// as it's pending) and carries a running estimate of what a redraw costs.
+// Every tick the scheduler walks the table, and before drawing a pending
+// widget checks whether its estimated cost still fits in what's left of
+// DISPLAY_FRAME_BUDGET_US. If not, it stops and resumes from that widget
+// on the next tick, so one busy frame (wake-up repaint, layer + locks +
+// WPM all changing together) is spread over several scans instead of
+// stalling the matrix for all of it.
+//
+// The first widget drawn in a tick always runs, whatever its estimate —
+// a single draw can't be split, and refusing it would starve it forever.
+//
+// Costs are measured with the RP2040's free-running 1MHz timer and folded
+// into the estimate as a 1/4 EMA, so the seeds below only matter for the
+// first few frames.
+
+#ifndef DISPLAY_FRAME_BUDGET_US
+#    define DISPLAY_FRAME_BUDGET_US 1000
+#endif
+
+typedef struct {
+    bool (*pending)(void);  // Cheap "anything to redraw?" check
+    void (*draw)(void);     // The expensive part
+    uint16_t interval_ms;   // Minimum time between redraws
+    uint16_t cost_us;       // Running estimate of draw()
+    uint32_t last_draw;     // timer_read32() of the last draw
+    bool idle;              // Runs in idle mode (true) or info mode (false)
+} display_widget_t;
+
+// Table order is priority order within a tick
+static display_widget_t widgets[] = {
+    { layer_name_pending, draw_layer_name, 0,   50,   0, false },
+    { layer_fade_pending, draw_layer_fade, LAYER_FADE_FRAME, 200, 0, false },
+    { locks_pending,      draw_locks,      0,   2000, 0, false },
+#ifdef HLC_WPM_BIG_DIGITS
+    { wpm_pending,        draw_wpm_big,    250, 2000, 0, false }, // 4 Hz, in Tux's spot
+#else
+    { wpm_pending,        draw_wpm,        250, 2000, 0, false }, // 4 Hz
+    { tux_pending,        draw_tux,        0,   6000, 0, false },
+#endif
+    { gol_pending,        draw_gol_frame,  100, 8000, 0, true  }, // 10 fps
+};
+
+#define NUM_WIDGETS (sizeof(widgets) / sizeof(widgets[0]))
+
+static uint8_t widget_resume = 0; // Where a deferred tick picks up again
+
+static void run_widgets(bool idle) {
+    uint32_t start = timer_hw->timerawl;
+    uint32_t now   = timer_read32();
+    bool drew      = false;
+
+    for (uint8_t n = 0; n < NUM_WIDGETS; n++) {
+        uint8_t i = (widget_resume + n) % NUM_WIDGETS;
+        display_widget_t *w = &widgets[i];
+
+        if (w->idle != idle) continue;
+        if (TIMER_DIFF_32(now, w->last_draw) < w->interval_ms) continue;
+        if (!w->pending()) continue;
+
+        uint32_t spent = timer_hw->timerawl - start;
+        if (drew && spent + w->cost_us > DISPLAY_FRAME_BUDGET_US) {
+            widget_resume = i; // Out of budget — this one goes first next tick
+            return;
+        }
+
+        uint32_t t0 = timer_hw->timerawl;
+        w->draw();
+        uint32_t took = timer_hw->timerawl - t0;
+
+        if (took > UINT16_MAX) took = UINT16_MAX;
+        w->cost_us   = (3 * (uint32_t)w->cost_us + took) / 4;
+        w->last_draw = now;
+        drew         = true;
     }
 
-    draw_layer_name(false);
-    draw_wpm(false);
-    draw_locks(false);
-    draw_tux();
+    widget_resume = 0;
 }
 
 // ==========================================================================
@@ -349,11 +1226,11 @@ void module_suspend_wakeup_init_kb(void) {
 bool module_post_init_kb(void) {
     backlight_enable();
 
-    // Create the ST7789 SPI device and the offscreen surface buffer
+    // Create the ST7789 SPI device and the boot-time scratch surface
     lcd = qp_st7789_make_spi_device(LCD_WIDTH, LCD_HEIGHT, LCD_CS_PIN,
                                      LCD_DC_PIN, LCD_RST_PIN,
                                      LCD_SPI_DIVISOR, LCD_SPI_MODE);
-    lcd_surface = qp_make_rgb565_surface(LCD_WIDTH, LCD_HEIGHT, lcd_surface_fb);
+    lcd_surface = qp_make_rgb565_surface(LCD_WIDTH, SCRATCH_HEIGHT, display_ram.scratch);
 
     // Initialize LCD hardware
     qp_init(lcd, LCD_ROTATION);
@@ -363,11 +1240,11 @@ bool module_post_init_kb(void) {
     qp_power(lcd, true);
     qp_flush(lcd);
 
-    // Initialize the offscreen surface
+    // Rasterise fonts and images once, then display_ram becomes the
+    // (all black) indexed framebuffer
     qp_init(lcd_surface, LCD_ROTATION);
-    qp_rect(lcd_surface, 0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1, 0, 0, 0, true);
-    qp_surface_draw(lcd_surface, lcd, 0, 0, 0);
-    qp_flush(lcd);
+    load_display_assets();
+    memset(&display_ram, 0, sizeof(display_ram));
 
     if (!module_post_init_user()) { return false; }
 
@@ -378,6 +1255,12 @@ bool module_post_init_kb(void) {
 bool display_module_housekeeping_task_kb(bool second_display) {
     if (!display_module_housekeeping_task_user(second_display)) { return false; }
 
+    // Cheap, every tick, so the pool is full long before idle mode needs it
+    entropy_harvest();
+
+    // Previous frame still on its way to the panel - don't draw over it
+    if (flush_busy()) { return true; }
+
     if (!second_display) {
         // This is the master (left half) — our only display
         uint32_t idle_time = last_input_activity_elapsed();
@@ -387,47 +1270,29 @@ bool display_module_housekeeping_task_kb(bool second_display) {
             if (!idle_mode) {
                 idle_mode = true;
                 // Clear the display before Game of Life takes over
-                qp_rect(lcd_surface, 0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1, 0, 0, 0, true);
-                srand(get_random_32bit());
+                fb_clear_rows(0, LCD_HEIGHT);
+                mark_all_dirty();
+                // Mix in the old PRNG state so back-to-back idles differ
+                // even if the pool barely moved
+                prng_seed(entropy_pool ^ prng_state);
                 init_grid();
-                color_value = rand() % NUM_LAYERS;
+                color_value = prng_next() % NUM_LAYERS;
             }
 
-            static uint32_t last_gol_draw = 0;
-            if (timer_elapsed32(last_gol_draw) >= 100) { // 10 fps
-                draw_grid();
-                update_grid();
-
-                // Slowly cycle colors every 5 seconds while idle
-                static uint32_t last_color_change = 0;
-                if (timer_elapsed32(last_color_change) >= 5000) {
-                    color_value = (color_value + 1) % NUM_LAYERS;
-                    add_cell_cluster();
-                    last_color_change = timer_read32();
-                }
-
-                last_gol_draw = timer_read32();
-                display_dirty = true;
-            }
+            run_widgets(true);
         } else {
             // ---- Active: info display ----
             if (idle_mode) {
-                // Just woke up — repaint everything
+                // Just woke up — repaint everything (spread over a few ticks)
                 idle_mode = false;
                 force_redraw_info();
-            } else {
-                // Normal incremental update
-                update_info_display();
             }
+            run_widgets(false);
         }
     }
 
-    // Only flush to LCD when the surface actually changed
-    if (display_dirty) {
-        qp_surface_draw(lcd_surface, lcd, 0, 0, true);
-        qp_flush(lcd);
-        display_dirty = false;
-    }
+    // Only send the rows that actually changed
+    flush_dirty_bands();
 
     return true;
 }
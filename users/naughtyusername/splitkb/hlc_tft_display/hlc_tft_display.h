@@ -32,7 +32,7 @@
 // ==========================================================================
 
 extern painter_device_t lcd;
-extern painter_device_t lcd_surface;
+extern painter_device_t lcd_surface; // Boot-time asset scratch, not the live framebuffer
 
 // ==========================================================================
 // Functions called from halcyon.c module system
@@ -7,3 +7,20 @@ SRC += $(USER_PATH)/splitkb/hlc_tft_display/graphics/fonts/Retron2000-27.qff.c \
 
 # Tux image (mono4 palette — recolorable at draw time)
 SRC += $(USER_PATH)/splitkb/hlc_tft_display/graphics/tux_100.qgf.c
+
+# Big-digit WPM gauge in place of Tux (numbers/0-9 mono2, downsampled 2x).
+# Opt-in: set HLC_WPM_BIG_DIGITS = yes in a keymap's rules.mk
+HLC_WPM_BIG_DIGITS ?= no
+ifeq ($(strip $(HLC_WPM_BIG_DIGITS)), yes)
+    SRC += $(USER_PATH)/splitkb/hlc_tft_display/graphics/numbers/0.qgf.c \
+           $(USER_PATH)/splitkb/hlc_tft_display/graphics/numbers/1.qgf.c \
+           $(USER_PATH)/splitkb/hlc_tft_display/graphics/numbers/2.qgf.c \
+           $(USER_PATH)/splitkb/hlc_tft_display/graphics/numbers/3.qgf.c \
+           $(USER_PATH)/splitkb/hlc_tft_display/graphics/numbers/4.qgf.c \
+           $(USER_PATH)/splitkb/hlc_tft_display/graphics/numbers/5.qgf.c \
+           $(USER_PATH)/splitkb/hlc_tft_display/graphics/numbers/6.qgf.c \
+           $(USER_PATH)/splitkb/hlc_tft_display/graphics/numbers/7.qgf.c \
+           $(USER_PATH)/splitkb/hlc_tft_display/graphics/numbers/8.qgf.c \
+           $(USER_PATH)/splitkb/hlc_tft_display/graphics/numbers/9.qgf.c
+    OPT_DEFS += -DHLC_WPM_BIG_DIGITS
+endif
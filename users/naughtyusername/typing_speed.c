@@ -0,0 +1,90 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * typing_speed.c - Hold-tap terms that follow how fast you're typing
+ *
+ * A fixed 175ms home row term is a compromise. Mid-burst at 100+ WPM, a
+ * rolled letter can sit down long enough to turn into a mod. On a slow,
+ * deliberate Ctrl+click that same 175ms is pure lag. This module tracks
+ * typing speed and shifts the terms between two configured bounds:
+ *
+ *   fast typing → longer tapping term, wider flow tap window (fewer mods)
+ *   slow / after a pause → shorter tapping term (mods arrive sooner)
+ *
+ * HOW SPEED IS TRACKED
+ * Every raw press comes in via pre_process_record_user(), before combos or
+ * tap-hold buffer anything, and is timed as it arrives on the 32-bit
+ * timer (a 16-bit gap wraps after ~65s, so a long pause could read as a
+ * short one). We keep an exponential moving average of the interval
+ * between presses (1/8 weight, Q4 fixed point) - a subtract and shift.
+ * Mapping the average onto the offsets costs one 32-bit divide per
+ * keypress, and nothing at all when the average is pinned at either end.
+ * Intervals are clamped to TYPING_SPEED_SLOW_MS, and a gap of
+ * TYPING_SPEED_PAUSE_MS or more resets the average to slow outright,
+ * so the first key after a pause is treated as deliberate.
+ *
+ * This is independent of WPM_ENABLE. get_current_wpm() is updated by a
+ * periodic decay task and reports words per minute. Here the reading is
+ * redone only on a press, and the term offsets are worked out then too,
+ * so get_tapping_term() just reads a cached value.
+ *
+ * HOW THE OFFSET IS DERIVED
+ * The average maps linearly from SLOW_MS (offset = *_SLOW) to FAST_MS
+ * (offset = *_FAST), clamped at both ends.
+ */
+
+#include "typing_speed.h"
+
+// Q4 fixed point: 16 units per ms
+#define Q4(ms) ((uint16_t)(ms) << 4)
+
+_Static_assert(TYPING_SPEED_FAST_MS < TYPING_SPEED_SLOW_MS,
+               "TYPING_SPEED_FAST_MS must be below TYPING_SPEED_SLOW_MS");
+_Static_assert(Q4(TYPING_SPEED_SLOW_MS) < 0x8000,
+               "TYPING_SPEED_SLOW_MS too large for Q4");
+
+static uint32_t last_press = 0;
+static uint16_t interval_avg = Q4(TYPING_SPEED_SLOW_MS); // Q4 ms
+
+static int16_t hold_offset = TYPING_SPEED_HOLD_SLOW;
+static int16_t flow_offset = TYPING_SPEED_FLOW_SLOW;
+
+// slow + (fast - slow) * speed / 256, speed 0 (slow) .. 256 (fast)
+static int16_t speed_lerp(int16_t slow, int16_t fast, uint16_t speed) {
+    return slow + (int16_t)(((int32_t)(fast - slow) * speed) >> 8);
+}
+
+void process_typing_speed(keyrecord_t *record) {
+    if (!IS_KEYEVENT(record->event) || !record->event.pressed) {
+        return;
+    }
+
+    uint32_t gap = timer_elapsed32(last_press);
+    last_press = timer_read32();
+
+    if (gap >= TYPING_SPEED_PAUSE_MS) {
+        interval_avg = Q4(TYPING_SPEED_SLOW_MS);
+    } else {
+        uint16_t sample =
+            Q4(gap < TYPING_SPEED_SLOW_MS ? gap : TYPING_SPEED_SLOW_MS);
+        interval_avg += ((int16_t)(sample - interval_avg)) >> 3;
+    }
+
+    // 0 at SLOW_MS or slower, 256 at FAST_MS or faster
+    uint16_t speed = 0;
+    if (interval_avg <= Q4(TYPING_SPEED_FAST_MS)) {
+        speed = 256;
+    } else if (interval_avg < Q4(TYPING_SPEED_SLOW_MS)) {
+        speed = ((uint32_t)(Q4(TYPING_SPEED_SLOW_MS) - interval_avg) << 8) /
+                (Q4(TYPING_SPEED_SLOW_MS) - Q4(TYPING_SPEED_FAST_MS));
+    }
+
+    hold_offset =
+        speed_lerp(TYPING_SPEED_HOLD_SLOW, TYPING_SPEED_HOLD_FAST, speed);
+    flow_offset =
+        speed_lerp(TYPING_SPEED_FLOW_SLOW, TYPING_SPEED_FLOW_FAST, speed);
+}
+
+int16_t typing_speed_hold_offset(void) { return hold_offset; }
+
+int16_t typing_speed_flow_offset(void) { return flow_offset; }
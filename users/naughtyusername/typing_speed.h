@@ -0,0 +1,61 @@
+/* Copyright 2025 naughtyusername
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * typing_speed.h - Typing-speed-aware hold-tap terms (opt-in)
+ *
+ * Enable with TYPING_SPEED_TERM = yes in rules.mk. See typing_speed.c for
+ * how speed is tracked and turned into term offsets.
+ */
+
+#pragma once
+
+#include "naughtyusername.h"
+
+/* ==========================================================================
+ * TUNABLES
+ * ==========================================================================
+ * All times in ms. Override any of these in config.h.
+ */
+
+// Average key-to-key interval that counts as full speed (~120 WPM)
+#ifndef TYPING_SPEED_FAST_MS
+#    define TYPING_SPEED_FAST_MS 100
+#endif
+
+// Average interval that counts as slow / deliberate (~50 WPM)
+#ifndef TYPING_SPEED_SLOW_MS
+#    define TYPING_SPEED_SLOW_MS 250
+#endif
+
+// A gap this long is a pause, not a keystroke - speed reads slow right away
+#ifndef TYPING_SPEED_PAUSE_MS
+#    define TYPING_SPEED_PAUSE_MS 500
+#endif
+
+// Offset added to finger-position tapping terms when slow / at full speed.
+// Slow: mods arrive sooner. Fast: rolls need a longer hold to become mods.
+#ifndef TYPING_SPEED_HOLD_SLOW
+#    define TYPING_SPEED_HOLD_SLOW -25
+#endif
+#ifndef TYPING_SPEED_HOLD_FAST
+#    define TYPING_SPEED_HOLD_FAST 25
+#endif
+
+// Offset added to FLOW_TAP_TERM when slow / at full speed
+#ifndef TYPING_SPEED_FLOW_SLOW
+#    define TYPING_SPEED_FLOW_SLOW 0
+#endif
+#ifndef TYPING_SPEED_FLOW_FAST
+#    define TYPING_SPEED_FLOW_FAST 25
+#endif
+
+/* ==========================================================================
+ * API
+ * ==========================================================================
+ */
+
+void process_typing_speed(keyrecord_t *record);
+
+// Current offsets, recomputed once per keypress - reading them is free
+int16_t typing_speed_hold_offset(void);
+int16_t typing_speed_flow_offset(void);
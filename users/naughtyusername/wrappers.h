@@ -258,6 +258,16 @@
 #define ___BLANK_R2___ _______, _______, _______, _______, _______
 #define ___BLANK_R3___ _______, _______, _______, _______, _______
 
+/* --------------------------------------------------------------------------
+ * FINGER MAP - Not a layer: which finger presses each key (hold_tap_fingers)
+ * --------------------------------------------------------------------------
+ * Every row is the same - fingers follow columns. Index covers two.
+ *
+ *  LP    LR    LM    LI    LI         RI    RI    RM    RR    RP
+ */
+#define ___FINGER_L___ FNG_LP, FNG_LR, FNG_LM, FNG_LI, FNG_LI
+#define ___FINGER_R___ FNG_RI, FNG_RI, FNG_RM, FNG_RR, FNG_RP
+
 /* ==========================================================================
  * THUMB CLUSTER MACROS - Keyboard Specific
  * ==========================================================================
@@ -353,6 +363,13 @@
 #define ___MITOSIS_THUMB_MOUSE_R1___ _______, _______, _______, _______
 #define ___MITOSIS_THUMB_MOUSE_R2___ MS_BTN1, MS_BTN2, _______, _______
 
+/* Finger map thumbs - thumbs use the default terms */
+#define ___MITOSIS_THUMB_FINGER_L1___ FNG_NO, FNG_NO, FNG_NO, FNG_NO
+#define ___MITOSIS_THUMB_FINGER_L2___ FNG_NO, FNG_NO, FNG_NO, FNG_NO
+
+#define ___MITOSIS_THUMB_FINGER_R1___ FNG_NO, FNG_NO, FNG_NO, FNG_NO
+#define ___MITOSIS_THUMB_FINGER_R2___ FNG_NO, FNG_NO, FNG_NO, FNG_NO
+
 /* ==========================================================================
  * CORNE THUMBS (3 keys per side)
  * ==========================================================================
@@ -393,6 +410,10 @@
 #define ___CORNE_THUMB_MOUSE___                                                \
     _______, MS_BTN2, MS_BTN1, MS_BTN1, MS_BTN2, _______
 
+/* Finger map thumbs - thumbs use the default terms */
+#define ___CORNE_THUMB_FINGER___                                               \
+    FNG_NO, FNG_NO, FNG_NO, FNG_NO, FNG_NO, FNG_NO
+
 /*
  * ==========================================================================
  * KYRIA THUMBS (5 keys per side, plus the extra two on row 3)
@@ -451,6 +472,11 @@ _______, _______, _______, _______, _______
 #define ___KYRIA_THUMB_MOUSE___                                                \
 _______, _______, _______, MS_BTN2, MS_BTN1,                                   \
 MS_BTN1, MS_BTN2, _______, _______, _______
+
+/* Finger map thumbs - thumbs use the default terms */
+#define ___KYRIA_THUMB_FINGER___                                               \
+FNG_NO, FNG_NO, FNG_NO, FNG_NO, FNG_NO,                                        \
+FNG_NO, FNG_NO, FNG_NO, FNG_NO, FNG_NO
 // clang-format on
 
 /* ==========================================================================
@@ -529,6 +555,12 @@ MS_BTN1, MS_BTN2, _______, _______, _______
     MS_BTN1,                                                                   \
     MS_BTN2, _______, _______, _______, _______
 
+/* Finger map bottom row - thumbs and mods use the default terms */
+#define ___PLANCK_BOTTOM_FINGER___                                             \
+    FNG_NO, FNG_NO, FNG_NO, FNG_NO, FNG_NO,                                    \
+    FNG_NO,                                                                    \
+    FNG_NO, FNG_NO, FNG_NO, FNG_NO, FNG_NO
+
 /* ==========================================================================
  * 6-COLUMN EXPANSION MACROS
  * ==========================================================================
@@ -646,6 +678,10 @@ MS_BTN1, MS_BTN2, _______, _______, _______
 #define ___BLANK_R2_6___ ___BLANK_R2___, _______
 #define ___BLANK_R3_6___ ___BLANK_R3___, _______
 
+// Finger map with outer columns (pinky reaches)
+#define ___FINGER_L_6___ FNG_LP, ___FINGER_L___
+#define ___FINGER_R_6___ ___FINGER_R___, FNG_RP
+
 /* ==========================================================================
  * KYRIA ROW 3 EXPANSION (8 keys - adds inner keys beside thumb cluster)
  * ==========================================================================
@@ -700,4 +736,8 @@ MS_BTN1, MS_BTN2, _______, _______, _______
 // Mouse
 #define ___MOUSE_L3_8___ ___MOUSE_L3_6___, _______, _______
 #define ___MOUSE_R3_8___ _______, _______, ___MOUSE_R3_6___
+
+// Finger map - inner keys are thumb reach
+#define ___FINGER_L3_8___ ___FINGER_L_6___, FNG_NO, FNG_NO
+#define ___FINGER_R3_8___ FNG_NO, FNG_NO, ___FINGER_R_6___
 // clang-format on